@@ -389,9 +389,11 @@ bool DataIngestionServer::saveDataToDatabase(const std::string& data_id, const s
     }
     
     bool success = true;
+    // Bound text must outlive the step, so keep the symbol in scope
+    std::string symbol = data_id.substr(0, data_id.find_last_of('_'));
     for (const auto& ohlcv : data) {
         sqlite3_bind_text(stmt, 1, data_id.c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_text(stmt, 2, data_id.substr(0, data_id.find_last_of('_')).c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 2, symbol.c_str(), -1, SQLITE_STATIC);
         sqlite3_bind_text(stmt, 3, ohlcv.timestamp.c_str(), -1, SQLITE_STATIC);
         sqlite3_bind_double(stmt, 4, ohlcv.open);
         sqlite3_bind_double(stmt, 5, ohlcv.high);
@@ -417,7 +419,6 @@ bool DataIngestionServer::saveDataToDatabase(const std::string& data_id, const s
         
         rc = sqlite3_prepare_v2(db_->db, info_sql, -1, &stmt, nullptr);
         if (rc == SQLITE_OK) {
-            std::string symbol = data_id.substr(0, data_id.find_last_of('_'));
             size_t pos = date_range.find(" - ");
             std::string start_date = (pos != std::string::npos) ? date_range.substr(0, pos) : "";
             std::string end_date = (pos != std::string::npos) ? date_range.substr(pos + 3) : "";
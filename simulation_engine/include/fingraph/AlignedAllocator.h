@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace fingraph {
+
+// Cache-line size assumed for column buffers; also the widest SIMD register (AVX-512).
+inline constexpr size_t kCacheLineSize = 64;
+
+/**
+ * @class AlignedAllocator
+ * @brief std::allocator replacement that returns storage aligned to `Alignment` bytes.
+ *
+ * Column buffers use it so that every column starts on a cache line and can be
+ * streamed with aligned vector loads.
+ */
+template <typename T, size_t Alignment = kCacheLineSize>
+class AlignedAllocator {
+public:
+    static_assert(Alignment >= alignof(T), "Alignment must not weaken the natural alignment of T");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T> >;
+
+} // namespace fingraph
@@ -1,26 +1,71 @@
 #pragma once
 
+#include "fingraph/CostModel.h"
 #include "fingraph/MarketData.h"
+#include "fingraph/OrderBook.h"
 #include "fingraph/Strategy.h"
 #include "fingraph/Portfolio.h"
 #include "fingraph/PerformanceMetrics.h"
+#include <algorithm>
+#include <cmath>
+#include <concepts>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace fingraph {
 
+class MarketDataStream;
+
 struct BacktestResult {
     double totalReturn = 0.0;
     double sharpeRatio = 0.0;
     double maxDrawdown = 0.0;
     double winRate = 0.0;
-    std::vector<Trade> trades;
+    // Commissions plus slippage: what the fills cost against their reference prices.
+    double totalCosts = 0.0;
+    TradeLog trades;
+    // Names of the symbol ids in `trades`.
+    SymbolTable symbols;
     // A time-series of the total portfolio value.
     std::vector<std::pair<std::chrono::system_clock::time_point, double> > equityCurve;
 };
 
+// Protective exits the engine rests with every position it opens, as fractions of
+// the entry price; 0 leaves one out. A run reads them from its parameters
+// "stopLoss", "takeProfit" and "trailingStop" (0.05 for 5%), next to the
+// strategy's own. The stops are checked against each later bar's high and low, so
+// they fill intrabar; whichever exit fills first closes the position and cancels
+// the others, as does a SELL signal.
+struct ExitRules {
+    double stopLoss = 0.0;
+    double takeProfit = 0.0;
+    double trailingStop = 0.0;
+
+    bool any() const { return stopLoss > 0 || takeProfit > 0 || trailingStop > 0; }
+    // Throws std::invalid_argument for a negative fraction or a stop-loss of 100% or more.
+    static ExitRules fromParameters(const std::map<std::string, double>& params);
+};
+
+// Strategies whose calls can be bound at compile time: a final Strategy class.
+// BacktestEngine runs these through a simulation loop instantiated for the type,
+// in which signal generation inlines next to the fills and the equity update.
+template <typename T>
+concept CompiledStrategy = std::derived_from<T, Strategy> && std::is_final_v<T>;
+
+/**
+ * @class BacktestEngine
+ * @brief Runs backtests of registered strategies by name; one engine can serve many threads.
+ *
+ * The registry holds a prototype of each strategy. Every run works on its own
+ * instance, reset from the prototype, so concurrent runs never share strategy
+ * state. Finished instances are kept in a small per-strategy pool and handed to
+ * later runs, which then reuse their signal buffers instead of allocating new ones.
+ * Register strategies and set the indicator cache before sharing the engine.
+ */
 class BacktestEngine {
 public:
     BacktestEngine();
@@ -34,15 +79,298 @@ public:
         double initialCash
     );
 
+    // Runs a backtest over already-loaded data (e.g. shared from a DatasetCache).
+    // With an indicator cache set, a non-empty `datasetKey` lets the run share
+    // indicators with other runs over the same bars (see Strategy::setIndicatorCache).
+    BacktestResult runBacktest(
+        const MarketDataView& data,
+        const std::string& strategyName,
+        const std::map<std::string, double>& strategyParams,
+        double initialCash,
+        const std::string& datasetKey = {}
+    );
+
+    // Runs a backtest over a stream, holding only the strategy's lookback plus one
+    // block of bars in memory. The strategy must have a finite getMaxLookback(); the
+    // metrics are accumulated on the fly and equityCurve is left empty.
+    BacktestResult runBacktest(
+        MarketDataStream& stream,
+        const std::string& strategyName,
+        const std::map<std::string, double>& strategyParams,
+        double initialCash
+    );
+
+    // The strategy's getMaxLookback() under `strategyParams`: the bars it needs
+    // before its first signal.
+    size_t getMaxLookback(const std::string& strategyName, const std::map<std::string, double>& strategyParams);
+
     // Returns a list of available strategy names.
     std::vector<std::string> getAvailableStrategies() const;
 
+    // Makes `prototype` available under its name, replacing any strategy of that name.
+    // Runs work on copies of it, so StrategyT must be copyable. A CompiledStrategy
+    // gets its own specialized loop; any other strategy is driven through the
+    // virtual generateSignals().
+    template <typename StrategyT>
+    void registerStrategy(std::unique_ptr<StrategyT> prototype);
+
+    // Indicator cache for runs given a dataset key; null (the default) disables it.
+    void setIndicatorCache(IndicatorCache* cache) { indicatorCache_ = cache; }
+
 private:
-    // Factory to create strategy instances by name.
-    std::map<std::string, std::unique_ptr<Strategy> > strategies_;
+    // Idle instances kept per strategy for later runs.
+    static constexpr size_t kMaxIdleInstances = 16;
+
+    // One run's trading state: the portfolio, its cost model and the order book
+    // holding the exits of its open position.
+    struct Execution {
+        Execution(Portfolio& portfolio, const ExitRules& exits, const TransactionCosts& costModel)
+            : portfolio(portfolio), exits(exits), costModel(costModel) {}
+
+        Portfolio& portfolio;
+        ExitRules exits;
+        TransactionCosts costModel;
+        double costsPaid = 0.0;
+        OrderBook orders;
+        std::vector<OrderId> exitOrders; // Resting exits of the open position
+        std::vector<Fill> fills;         // Scratch for fillOrders()
+
+        // Trades `symbol` on `signal` at the bar's close: all-in on BUY, flatten on SELL.
+        template <typename Costs>
+        void executeSignal(Signal signal, SymbolId symbol, double close, double volume,
+                           std::chrono::system_clock::time_point timestamp, const Costs& costs);
+        // Fills the resting orders the bar triggers. Fills the portfolio can no longer
+        // cover (a second exit in the same bar) are dropped.
+        template <typename Costs>
+        void fillOrders(SymbolId symbol, double open, double high, double low, double volume,
+                        std::chrono::system_clock::time_point timestamp, const Costs& costs);
+        // Trades `quantity` at `price` plus the costs; returns the fill price. With a
+        // `limit` (a LIMIT order's price, 0 for none) the fill is never worse than it.
+        template <typename Costs>
+        double trade(TradeType side, SymbolId symbol, double quantity, double price, double volume,
+                     std::chrono::system_clock::time_point timestamp, const Costs& costs, double limit = 0.0);
+        // `price` moved against the trader by the costs, but not past `limit`.
+        template <typename Costs>
+        static double fillPrice(TradeType side, double price, double quantity, double volume, const Costs& costs,
+                                double limit);
+        void placeExits(SymbolId symbol, double quantity, double entryPrice);
+        void cancelExits();
+    };
+
+    // Runs an initialized strategy over `data`, appending to result.equityCurve.
+    using SimulateFunction = void (*)(const Strategy& strategy, const MarketDataView& data,
+                                      Execution& execution, BacktestResult& result);
+    // Makes `instance` a copy of `prototype`: a new one if null, else by assignment,
+    // which keeps the buffers the instance has already allocated.
+    using ResetFunction = void (*)(const Strategy& prototype, std::unique_ptr<Strategy>& instance);
+
+    struct RegisteredStrategy {
+        std::unique_ptr<Strategy> prototype;
+        SimulateFunction simulate;          // Without costs
+        SimulateFunction simulateWithCosts; // Applying Execution::costModel
+        ResetFunction reset;
+        std::vector<std::unique_ptr<Strategy> > idle; // Guarded by poolMutex_
+    };
+
+    // Checks out an instance for one run and returns it to the pool afterwards.
+    class StrategyLease;
+
+    // Registry of strategy prototypes by name.
+    std::map<std::string, RegisteredStrategy> strategies_;
+    std::mutex poolMutex_;
+
+    IndicatorCache* indicatorCache_ = nullptr;
 
     void initializeStrategies();
-    Strategy* getStrategy(const std::string& name);
+    RegisteredStrategy& getStrategy(const std::string& name);
+
+    // The cost policy the loops instantiated for Costs apply.
+    template <typename Costs>
+    static const Costs& getCosts(const Execution& execution) {
+        if constexpr (std::is_same_v<Costs, TransactionCosts>) {
+            return execution.costModel;
+        } else {
+            static const Costs costs{};
+            return costs;
+        }
+    }
+
+    // The loop for strategies known only through the Strategy interface.
+    template <typename Costs>
+    static void simulateVirtual(const Strategy& strategy, const MarketDataView& data,
+                                Execution& execution, BacktestResult& result);
+    // The loop specialized for StrategyT.
+    template <CompiledStrategy StrategyT, typename Costs>
+    static void simulateCompiled(const Strategy& strategy, const MarketDataView& data,
+                                 Execution& execution, BacktestResult& result);
+
+    // Fills resting orders within bar i, then trades on signalAt(i) at its close, for
+    // bars [begin, data.size()), calling record(timestamp, portfolio value) after each bar.
+    template <typename SignalAt, typename Costs, typename RecordValue>
+    static void simulate(SignalAt&& signalAt, const MarketDataView& data, size_t begin,
+                         Execution& execution, const Costs& costs, RecordValue&& record);
 };
 
+template <typename StrategyT>
+void BacktestEngine::registerStrategy(std::unique_ptr<StrategyT> prototype) {
+    static_assert(std::derived_from<StrategyT, Strategy>, "registerStrategy needs a Strategy");
+    static_assert(std::is_copy_constructible_v<StrategyT> && std::is_copy_assignable_v<StrategyT>,
+                  "each run works on a copy of the registered strategy");
+    RegisteredStrategy entry;
+    entry.simulate = &simulateVirtual<NoCosts>;
+    entry.simulateWithCosts = &simulateVirtual<TransactionCosts>;
+    if constexpr (CompiledStrategy<StrategyT>) {
+        entry.simulate = &simulateCompiled<StrategyT, NoCosts>;
+        entry.simulateWithCosts = &simulateCompiled<StrategyT, TransactionCosts>;
+    }
+    entry.reset = [](const Strategy& prototype, std::unique_ptr<Strategy>& instance) {
+        const StrategyT& typed = static_cast<const StrategyT&>(prototype);
+        if (instance) {
+            *static_cast<StrategyT*>(instance.get()) = typed;
+        } else {
+            instance = std::make_unique<StrategyT>(typed);
+        }
+    };
+    std::string name = prototype->getName();
+    entry.prototype = std::move(prototype);
+    strategies_[name] = std::move(entry);
+}
+
+template <typename Costs>
+void BacktestEngine::simulateVirtual(const Strategy& strategy, const MarketDataView& data,
+                                     Execution& execution, BacktestResult& result) {
+    // All signals in one virtual call, then a loop that only touches the price and timestamp columns
+    std::vector<Signal> signals(data.size());
+    strategy.generateSignals(signals);
+    simulate([&signals](size_t i) { return signals[i]; }, data, 0, execution, getCosts<Costs>(execution),
+             [&result](int64_t timestamp, double totalValue) {
+                 result.equityCurve.emplace_back(toTimePoint(timestamp), totalValue);
+             });
+}
+
+template <CompiledStrategy StrategyT, typename Costs>
+void BacktestEngine::simulateCompiled(const Strategy& strategy, const MarketDataView& data,
+                                      Execution& execution, BacktestResult& result) {
+    // StrategyT is final, so generateSignal() binds statically and inlines into the loop
+    const StrategyT& typed = static_cast<const StrategyT&>(strategy);
+    simulate([&typed](size_t i) { return typed.generateSignal(i); }, data, 0, execution,
+             getCosts<Costs>(execution), [&result](int64_t timestamp, double totalValue) {
+                 result.equityCurve.emplace_back(toTimePoint(timestamp), totalValue);
+             });
+}
+
+template <typename SignalAt, typename Costs, typename RecordValue>
+void BacktestEngine::simulate(SignalAt&& signalAt, const MarketDataView& data, size_t begin,
+                              Execution& execution, const Costs& costs, RecordValue&& record) {
+    Portfolio& portfolio = execution.portfolio;
+    auto opens = data.getOpens();
+    auto highs = data.getHighs();
+    auto lows = data.getLows();
+    auto closes = data.getCloses();
+    auto volumes = data.getVolumes();
+    auto timestamps = data.getTimestamps();
+    // Only trades change the position, so it is looked up after each trade rather than per bar
+    SymbolId symbol = portfolio.internSymbol("DEFAULT");
+    double position = portfolio.getPosition(symbol);
+    for (size_t i = begin; i < data.size(); ++i) {
+        if (execution.orders.hasOrders(symbol)) {
+            execution.fillOrders(symbol, opens[i], highs[i], lows[i], static_cast<double>(volumes[i]),
+                                 toTimePoint(timestamps[i]), costs);
+            position = portfolio.getPosition(symbol);
+        }
+        double close = closes[i];
+        Signal signal = signalAt(i);
+        if (signal != Signal::NONE) {
+            execution.executeSignal(signal, symbol, close, static_cast<double>(volumes[i]),
+                                    toTimePoint(timestamps[i]), costs);
+            position = portfolio.getPosition(symbol);
+        }
+        // Same value as getTotalValue({{"DEFAULT", close}}), without building the map
+        record(timestamps[i], portfolio.getCash() + position * close);
+    }
+}
+
+template <typename Costs>
+void BacktestEngine::Execution::executeSignal(Signal signal, SymbolId symbol, double close, double volume,
+                                              std::chrono::system_clock::time_point timestamp,
+                                              const Costs& costs) {
+    double position = portfolio.getPosition(symbol);
+    if (signal == Signal::BUY && position == 0) { // Simple logic: one open position
+        double cash = portfolio.getCash();
+        double quantity = std::floor(cash / close); // All-in
+        if constexpr (!Costs::kFree) {
+            // Slippage and commission grow with the size: shrink it until the buy is covered
+            while (quantity > 0) {
+                double fillPrice = costs.fillPrice(TradeType::BUY, close, quantity, volume);
+                double total = quantity * fillPrice + costs.commission(quantity, fillPrice);
+                if (total <= cash) {
+                    break;
+                }
+                quantity = std::min(quantity - 1, std::floor(quantity * cash / total));
+            }
+        }
+        if (quantity > 0) {
+            double fillPrice = trade(TradeType::BUY, symbol, quantity, close, volume, timestamp, costs);
+            placeExits(symbol, quantity, fillPrice);
+        }
+    } else if (signal == Signal::SELL && position > 0) {
+        trade(TradeType::SELL, symbol, position, close, volume, timestamp, costs);
+        cancelExits();
+    }
+}
+
+template <typename Costs>
+void BacktestEngine::Execution::fillOrders(SymbolId symbol, double open, double high, double low, double volume,
+                                           std::chrono::system_clock::time_point timestamp, const Costs& costs) {
+    fills.clear();
+    orders.processBar(symbol, open, high, low, fills);
+    for (const Fill& fill : fills) {
+        double quantity = fill.quantity;
+        if (fill.side == TradeType::SELL) {
+            quantity = std::min(quantity, portfolio.getPosition(fill.symbol));
+        }
+        if (quantity <= 0) {
+            continue;
+        }
+        double limit = fill.type == OrderType::LIMIT ? fill.orderPrice : 0.0;
+        if (fill.side == TradeType::BUY) {
+            double price = fillPrice(TradeType::BUY, fill.price, quantity, volume, costs, limit);
+            if (quantity * price + costs.commission(quantity, price) > portfolio.getCash()) {
+                continue;
+            }
+        }
+        trade(fill.side, fill.symbol, quantity, fill.price, volume, timestamp, costs, limit);
+    }
+    if (portfolio.getPosition(symbol) == 0) {
+        cancelExits();
+    }
+}
+
+template <typename Costs>
+double BacktestEngine::Execution::trade(TradeType side, SymbolId symbol, double quantity, double price,
+                                        double volume, std::chrono::system_clock::time_point timestamp,
+                                        const Costs& costs, double limit) {
+    if constexpr (Costs::kFree) {
+        portfolio.addTrade(TradeRecord{timestamp, quantity, price, symbol, side});
+        return price;
+    } else {
+        double fillPrice = Execution::fillPrice(side, price, quantity, volume, costs, limit);
+        double commission = costs.commission(quantity, fillPrice);
+        portfolio.addTrade(TradeRecord{timestamp, quantity, fillPrice, symbol, side}, commission);
+        costsPaid += commission + std::abs(fillPrice - price) * quantity;
+        return fillPrice;
+    }
+}
+
+template <typename Costs>
+double BacktestEngine::Execution::fillPrice(TradeType side, double price, double quantity, double volume,
+                                            const Costs& costs, double limit) {
+    double filled = costs.fillPrice(side, price, quantity, volume);
+    if (limit <= 0) {
+        return filled;
+    }
+    // A limit order never fills worse than its limit; a gap through it leaves room for the costs
+    return side == TradeType::BUY ? std::min(filled, limit) : std::max(filled, limit);
+}
+
 } // namespace fingraph
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+#include "fingraph/FileFingerprint.h"
+#include "fingraph/MarketData.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace fingraph {
+
+/**
+ * @struct ColumnarCacheHeader
+ * @brief On-disk header of a .fgc binary columnar market data file.
+ *
+ * Layout: this 256-byte header, then the timestamp/open/high/low/close/volume
+ * columns, each starting on a 64-byte boundary. Raw columns are plain arrays, so a
+ * memory-mapped file can be used directly as MarketData columns. Gorilla columns
+ * are a directory of `blockCount + 1` uint64 offsets (relative to the column) and
+ * then one GorillaCodec block per `blockRows` rows, so blocks decode independently.
+ * All values are in host byte order; `byteOrderMark` rejects files written on a
+ * machine of the other endianness.
+ */
+struct ColumnarCacheHeader {
+    static constexpr uint32_t kMagic = 0x31434746; // "FGC1"
+    static constexpr uint16_t kVersion = 2;
+    static constexpr uint32_t kDefaultBlockRows = 4096;
+    static constexpr uint16_t kByteOrderMark = 0x0102;
+    static constexpr uint32_t kColumnCount = 6;
+
+    uint32_t magic;
+    uint16_t version;
+    uint16_t byteOrderMark;
+    uint32_t headerSize;
+    uint32_t columnCount;
+    uint64_t rowCount;
+    int64_t minTimestamp;
+    int64_t maxTimestamp;
+    uint64_t rowsRejected;        // Malformed rows skipped when the source was parsed
+    FileFingerprint source;       // Identity of the CSV this cache was built from
+    uint64_t columnOffsets[kColumnCount];
+    uint64_t columnBytes[kColumnCount];
+    uint32_t encoding;            // A CacheEncoding
+    uint32_t blockRows;           // Rows per compressed block (Gorilla only)
+    uint8_t reserved[72];
+    uint64_t headerChecksum;      // FNV-1a of all preceding header bytes
+};
+
+/**
+ * @class ColumnarCache
+ * @brief Reads and writes .fgc files: a parsed CSV persisted column by column.
+ *
+ * The cache lives beside its source (`data.csv` -> `data.csv.fgc`) and is only
+ * used while the source's FileFingerprint still matches. Loading a raw cache is a
+ * header check plus an mmap, so every job and process touching the same dataset
+ * shares the same physical pages through the page cache. A Gorilla cache is
+ * several times smaller on disk and is decoded into private memory instead.
+ */
+class ColumnarCache {
+public:
+    static std::string cachePathFor(const std::string& sourcePath);
+
+    /**
+     * @brief Writes `data` to `cachePath` atomically (temporary file + rename).
+     * @return false if the file could not be written; the caller can carry on uncached.
+     */
+    static bool write(const std::string& cachePath, const MarketDataView& data,
+                      const FileFingerprint& source, const LoadReport& report,
+                      CacheEncoding encoding = CacheEncoding::Raw);
+
+    /**
+     * @brief Maps a cache file if it is well formed and was built from `expectedSource`.
+     * @param storage Receives the owner of the mapping; `view` is valid while it lives.
+     * @param view Receives column spans pointing into the mapping.
+     * @param report Receives the row counts recorded when the cache was written.
+     * @return false if the file is missing, stale or malformed.
+     */
+    static bool open(const std::string& cachePath, const FileFingerprint& expectedSource,
+                     std::shared_ptr<const void>& storage, MarketDataView& view, LoadReport& report);
+
+    /**
+     * @brief Checks a header read from a cache file of `fileSize` bytes.
+     * @return true if it is well formed, built from `expectedSource` and every column
+     *         lies inside the file.
+     */
+    static bool validateHeader(const ColumnarCacheHeader& header, uint64_t fileSize,
+                               const FileFingerprint& expectedSource);
+
+    /**
+     * @brief Decodes one compressed block of `column` into `out`, rows [at, at + rows).
+     * @return false if the block is malformed.
+     */
+    static bool decodeBlock(uint32_t column, const uint8_t* data, size_t size,
+                            size_t rows, ColumnBuffers& out, size_t at);
+};
+
+} // namespace fingraph
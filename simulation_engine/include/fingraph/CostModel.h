@@ -0,0 +1,124 @@
+#pragma once
+#include "fingraph/Trade.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+
+namespace fingraph {
+
+// Cost policies. Each prices one side of a fill of `quantity` shares at a
+// reference `price` (the bar's close for a signal, the order price for a resting
+// order) in a bar that traded `volume` shares, through either or both of:
+//   double slippage(double quantity, double price, double volume) const;
+//     how far the fill moves against the trader, per share;
+//   double commission(double quantity, double fillPrice) const;
+//     the fee, taken from cash.
+
+// A fee per fill, per share and per unit of traded value.
+struct Commission {
+    double perTrade = 0.0;
+    double perShare = 0.0;
+    double rate = 0.0;
+
+    double commission(double quantity, double fillPrice) const {
+        return perTrade + perShare * quantity + rate * quantity * fillPrice;
+    }
+    bool isFree() const { return perTrade == 0 && perShare == 0 && rate == 0; }
+};
+
+// Crossing half the quoted spread, a fraction of the price.
+struct Spread {
+    double spread = 0.0;
+
+    double slippage(double, double price, double) const { return price * spread * 0.5; }
+    bool isFree() const { return spread == 0; }
+};
+
+// A fixed adverse move, a fraction of the price.
+struct Slippage {
+    double rate = 0.0;
+
+    double slippage(double, double price, double) const { return price * rate; }
+    bool isFree() const { return rate == 0; }
+};
+
+// Square-root market impact: coefficient * price * sqrt(quantity / bar volume).
+// Bars without volume carry no impact.
+struct MarketImpact {
+    double coefficient = 0.0;
+
+    double slippage(double quantity, double price, double volume) const {
+        return volume > 0 ? coefficient * price * std::sqrt(quantity / volume) : 0.0;
+    }
+    bool isFree() const { return coefficient == 0; }
+};
+
+/**
+ * @class CostModel
+ * @brief Composes cost policies into the fill price and commission of a trade.
+ *
+ * The slippages of the policies add up, as do their commissions. The engine's
+ * simulation loop is instantiated per cost model: CostModel<> (NoCosts) has
+ * kFree set, and the loop then fills at the reference price with no cost code
+ * compiled in at all.
+ */
+template <typename... Policies>
+struct CostModel : Policies... {
+    static constexpr bool kFree = sizeof...(Policies) == 0;
+
+    // The price `quantity` shares actually trade at on `side`.
+    double fillPrice(TradeType side, double price, double quantity, double volume) const {
+        if constexpr (kFree) {
+            return price;
+        } else {
+            double adverse = (0.0 + ... + slippageOf<Policies>(quantity, price, volume));
+            return side == TradeType::BUY ? price + adverse : std::max(price - adverse, 0.0);
+        }
+    }
+
+    double commission(double quantity, double fillPrice) const {
+        if constexpr (kFree) {
+            return 0.0;
+        } else {
+            return (0.0 + ... + commissionOf<Policies>(quantity, fillPrice));
+        }
+    }
+
+    // Whether every policy is configured to cost nothing.
+    bool isFree() const { return (true && ... && static_cast<const Policies&>(*this).isFree()); }
+
+private:
+    template <typename Policy>
+    double slippageOf(double quantity, double price, double volume) const {
+        const Policy& policy = *this;
+        if constexpr (requires { policy.slippage(quantity, price, volume); }) {
+            return policy.slippage(quantity, price, volume);
+        } else {
+            return 0.0;
+        }
+    }
+
+    template <typename Policy>
+    double commissionOf(double quantity, double fillPrice) const {
+        const Policy& policy = *this;
+        if constexpr (requires { policy.commission(quantity, fillPrice); }) {
+            return policy.commission(quantity, fillPrice);
+        } else {
+            return 0.0;
+        }
+    }
+};
+
+using NoCosts = CostModel<>;
+
+// The runtime-configurable model: every policy, with parameters read per run.
+using TransactionCosts = CostModel<Commission, Spread, Slippage, MarketImpact>;
+
+// Reads a TransactionCosts from run parameters, all optional and zero by default:
+// "commissionPerTrade" and "commissionPerShare" (currency), "commissionBps",
+// "spreadBps" and "slippageBps" (basis points of the price), and
+// "impactCoefficient". Throws std::invalid_argument for a negative value.
+TransactionCosts transactionCostsFromParameters(const std::map<std::string, double>& params);
+
+} // namespace fingraph
@@ -0,0 +1,72 @@
+#pragma once
+#include "fingraph/MarketData.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace fingraph {
+
+class ThreadPool;
+
+/**
+ * @class CsvParser
+ * @brief Allocation-free parser for "timestamp,open,high,low,close,volume" rows.
+ *
+ * Works directly on a (usually memory-mapped) character buffer: fields are located
+ * with memchr, numbers are decoded with std::from_chars and timestamps with a
+ * fixed-layout ISO-8601 decoder that needs neither a locale nor mktime.
+ * Timestamps are interpreted as UTC.
+ */
+class CsvParser {
+public:
+    /**
+     * @brief Decodes "YYYY-MM-DD", optionally followed by ' ' or 'T' and
+     *        "HH:MM[:SS[.fff]]" and a trailing 'Z'.
+     * @param text The timestamp field.
+     * @param epochSeconds Receives seconds since the Unix epoch (UTC).
+     * @return false if the text is not a valid timestamp.
+     */
+    static bool parseTimestamp(std::string_view text, int64_t& epochSeconds);
+
+    /**
+     * @brief Parses a single data row. Columns after the sixth are ignored.
+     * @param line The row without its line terminator ('\r' is tolerated).
+     * @param bar Receives the parsed bar.
+     * @param error Set to a static description of the first bad field on failure.
+     * @return true if the row was parsed.
+     */
+    static bool parseRow(std::string_view line, OHLCV& bar, const char*& error);
+
+    /**
+     * @brief Parses every row in a block of text, appending good rows to `out`.
+     *
+     * Blank lines are skipped silently; malformed rows are counted in `report` and
+     * only the first LoadReport::kMaxReportedErrors of them are kept verbatim.
+     * Good rows are appended straight to the columns, with no per-row allocation.
+     *
+     * @param text A block of complete lines (no header).
+     * @param firstLineNumber The 1-based line number of the first line in `text`.
+     * @return The number of lines consumed, blank and malformed ones included.
+     */
+    static size_t parseRows(std::string_view text, size_t firstLineNumber,
+                            ColumnBuffers& out, LoadReport& report);
+
+    /**
+     * @brief parseRows split across a thread pool; the result is identical.
+     *
+     * `text` is cut into `chunkCount` pieces at line boundaries. Each piece is parsed
+     * into its own column buffers, and the pieces are then appended to `out` in file
+     * order, with error line numbers rebased onto the whole text.
+     */
+    static void parseRowsParallel(std::string_view text, size_t firstLineNumber,
+                                  ColumnBuffers& out, LoadReport& report,
+                                  ThreadPool& pool, size_t chunkCount);
+
+    // Returns the offset of the first byte after the header line.
+    static size_t skipHeader(std::string_view text);
+
+    // Estimates the number of rows in `text` from the length of its first lines.
+    static size_t estimateRowCount(std::string_view text);
+};
+
+} // namespace fingraph
@@ -11,6 +11,8 @@ using json = nlohmann::json;
 
 namespace fingraph {
 
+class MarketData;
+
 struct JobRecord {
     std::string id;
     std::string status;
@@ -59,6 +61,11 @@ public:
         const std::chrono::system_clock::time_point& start_time,
         const std::chrono::system_clock::time_point& end_time
     );
+    // Loads a symbol's bars with start_seconds <= timestamp <= end_seconds (epoch
+    // seconds, UTC) straight into `out`'s columns; 0 leaves that side open.
+    // Returns false if the query fails. Rows whose timestamp does not parse are skipped.
+    bool loadMarketData(const std::string& symbol, int64_t start_seconds, int64_t end_seconds,
+                        MarketData& out);
     std::vector<std::string> getAvailableSymbols();
     bool deleteMarketData(const std::string& symbol, 
                          const std::chrono::system_clock::time_point& before_time = {});
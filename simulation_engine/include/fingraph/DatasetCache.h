@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "fingraph/MarketData.h"
+#include "fingraph/SingleFlightLruCache.h"
+
+namespace fingraph {
+
+struct DatasetCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t load_failures = 0;
+    size_t entries = 0;
+    size_t bytes_in_use = 0;
+    size_t byte_budget = 0;
+};
+
+/**
+ * @class DatasetCache
+ * @brief Process-wide cache of loaded market data, shared by all jobs.
+ *
+ * Entries are immutable `std::shared_ptr<const MarketData>`, keyed by canonical
+ * path plus the file's content fingerprint, so an edited file is never served
+ * stale. Loads are coalesced and evicted as in a SingleFlightLruCache; jobs still
+ * holding an evicted dataset keep it alive until they finish. Resampled versions
+ * of a dataset are cached as entries of their own, so each timeframe is computed
+ * once per file version. Once a version of a file is cached, entries of the
+ * versions seen before it are dropped; a load of an older version that finishes
+ * later is served to its callers but not cached.
+ */
+class DatasetCache {
+public:
+    static constexpr size_t kDefaultByteBudget = size_t(1) << 30; // 1 GiB
+
+    explicit DatasetCache(size_t byte_budget = kDefaultByteBudget);
+
+    // Returns the dataset stored in a CSV file, loading it on a miss.
+    // Throws std::runtime_error if the file cannot be loaded.
+    std::shared_ptr<const MarketData> get(const std::string& file_path);
+
+    // Returns the dataset resampled to `bar_seconds` bars (see Resampler), computing
+    // it from the cached dataset on a miss. 0 returns the bars as stored.
+    std::shared_ptr<const MarketData> get(const std::string& file_path, int64_t bar_seconds);
+    // As above, also setting `dataset_key` to the entry's key: the file's canonical
+    // path, content fingerprint and timeframe. It changes whenever the file does.
+    std::shared_ptr<const MarketData> get(const std::string& file_path, int64_t bar_seconds,
+                                          std::string& dataset_key);
+
+    DatasetCacheStats getStats() const;
+    void setByteBudget(size_t byte_budget);
+    void clear();
+
+private:
+    using DatasetPtr = std::shared_ptr<const MarketData>;
+
+    struct Latest {
+        std::string version;
+        uint64_t sequence = 0;
+    };
+
+    // Resolves `file_path` to its canonical path and current version key, and
+    // numbers the lookup: a higher sequence saw the file later.
+    void identify(const std::string& file_path, std::string& canonical_path, std::string& version,
+                  uint64_t& sequence);
+    // Returns the dataset as stored in the file, loading it on a miss.
+    DatasetPtr getSource(const std::string& canonical_path, const std::string& version, uint64_t sequence);
+    // Returns the entry for `key`, running `load` on a miss; keys start with their version.
+    DatasetPtr getOrLoad(const std::string& key, const std::string& canonical_path,
+                         const std::string& version, uint64_t sequence,
+                         const std::function<DatasetPtr()>& load);
+
+    SingleFlightLruCache<DatasetPtr> cache_;
+    std::mutex versions_mutex_; // Taken inside the cache's lock
+    std::unordered_map<std::string, Latest> latest_by_path_; // Latest cached version per canonical path
+    std::atomic<uint64_t> next_sequence_{0};
+};
+
+} // namespace fingraph
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace fingraph {
+
+/**
+ * @struct FileFingerprint
+ * @brief Cheap identity of a file's contents: size, modification time and a
+ *        hash of its first and last 64 KiB.
+ *
+ * Used to decide whether derived data (binary caches, cached datasets) still
+ * matches its source file without re-reading the whole file.
+ */
+struct FileFingerprint {
+    uint64_t size = 0;
+    int64_t mtimeNs = 0;
+    uint64_t sampleHash = 0;
+
+    // Returns false if the file cannot be stat'ed or read.
+    static bool compute(const std::string& filePath, FileFingerprint& out);
+
+    // Folds size, mtime and hash into one 64-bit value.
+    uint64_t combined() const;
+
+    bool operator==(const FileFingerprint& other) const = default;
+};
+
+// 64-bit FNV-1a, seeded so that several buffers can be chained.
+uint64_t fnv1a64(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ULL);
+
+} // namespace fingraph
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace fingraph {
+
+/**
+ * @class GorillaCodec
+ * @brief Lossless compression of one block of a market data column.
+ *
+ * Follows the Gorilla time-series encodings: timestamps are stored as
+ * delta-of-deltas in variable-width bit buckets (regular bars cost one bit each),
+ * and doubles as the XOR with their predecessor. Prices that are exact decimals
+ * (as parsed from CSV, e.g. 101.25) are instead scaled to integers and stored as
+ * zig-zag varint deltas, which is far tighter than XOR for such data; values are
+ * only stored that way when they decode bit for bit. Volumes are LEB128 varints.
+ *
+ * Encoders append to `out`. Decoders write exactly `count` values and return false
+ * if the input is truncated or malformed; they never read past `size` bytes.
+ */
+class GorillaCodec {
+public:
+    static void encodeTimestamps(std::span<const int64_t> values, std::vector<uint8_t>& out);
+    static bool decodeTimestamps(const uint8_t* data, size_t size, size_t count, int64_t* out);
+
+    static void encodeDoubles(std::span<const double> values, std::vector<uint8_t>& out);
+    static bool decodeDoubles(const uint8_t* data, size_t size, size_t count, double* out);
+
+    static void encodeVarints(std::span<const uint64_t> values, std::vector<uint8_t>& out);
+    static bool decodeVarints(const uint8_t* data, size_t size, size_t count, uint64_t* out);
+};
+
+} // namespace fingraph
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include "fingraph/AlignedAllocator.h"
+#include "fingraph/SingleFlightLruCache.h"
+
+namespace fingraph {
+
+struct IndicatorCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t compute_failures = 0;
+    size_t entries = 0;
+    size_t bytes_in_use = 0;
+    size_t byte_budget = 0;
+};
+
+/**
+ * @class IndicatorCache
+ * @brief Process-wide cache of computed indicator columns, shared by all jobs.
+ *
+ * Lives beside the DatasetCache: a parameter sweep runs many jobs over the same
+ * bars, and each indicator (say a 50-bar SMA of the closes) only needs computing
+ * once for all of them. Entries are immutable column buffers keyed by a dataset
+ * key, which must identify the exact bars the indicator was computed from (file
+ * version, timeframe and window), plus an indicator key naming the indicator and
+ * its parameters, e.g. "SMA(close,50)". Columns are computed and evicted as in a
+ * SingleFlightLruCache, so concurrent misses on one key compute it once.
+ */
+class IndicatorCache {
+public:
+    using Column = std::shared_ptr<const AlignedVector<double>>;
+
+    static constexpr size_t kDefaultByteBudget = size_t(256) << 20; // 256 MiB
+
+    explicit IndicatorCache(size_t byte_budget = kDefaultByteBudget);
+
+    // Returns the `size`-value column cached under the two keys, filling a new one
+    // with `compute` on a miss. Exceptions from `compute` propagate to every caller
+    // waiting on that key, and nothing is cached.
+    Column get(const std::string& dataset_key, const std::string& indicator_key, size_t size,
+               const std::function<void(std::span<double>)>& compute);
+
+    IndicatorCacheStats getStats() const;
+    void setByteBudget(size_t byte_budget);
+    void clear();
+
+private:
+    SingleFlightLruCache<Column> cache_;
+};
+
+} // namespace fingraph
@@ -13,6 +13,10 @@
 #include <map>
 #include <vector>
 #include "fingraph/Backtest.h"
+#include "fingraph/DatasetCache.h"
+#include "fingraph/IndicatorCache.h"
+#include "fingraph/ParameterSweep.h"
+#include "fingraph/WalkForward.h"
 #include "fingraph/Trade.h"
 
 namespace fingraph {
@@ -31,6 +35,36 @@ struct BacktestRequest {
     std::map<std::string, double> strategy_params;
     double initial_cash;
     std::string job_id;
+    // Optional backtest window in epoch milliseconds (inclusive); 0 leaves that side open
+    int64_t start_time = 0;
+    int64_t end_time = 0;
+    // Resample to bars of this many seconds before the backtest; 0 uses the bars as stored
+    int64_t bar_seconds = 0;
+    // When set, data_path is a market database and this symbol's bars are read from it
+    std::string symbol;
+};
+
+// A grid search as one job: the data, strategy and cash of `backtest`, whose
+// strategy_params hold the parameters that stay fixed, plus the swept axes.
+struct SweepRequest {
+    BacktestRequest backtest;
+    std::vector<ParameterAxis> axes;
+    SweepMetric metric = SweepMetric::SHARPE_RATIO;
+    size_t top_k = 10;
+    // GRID runs every point; the searches run a fraction of its bars, GENETIC trading
+    // away the grid's exact best point for it (see ParameterSweep)
+    SweepMode mode = SweepMode::GRID;
+    SuccessiveHalvingOptions halving;
+    GeneticOptions genetic;
+};
+
+// Walk-forward analysis as one job: each fold searches the sweep's grid in sample
+// (by its metric and mode) and trades the best point out of sample.
+struct WalkForwardRequest {
+    SweepRequest sweep;
+    size_t in_sample_bars = 0;
+    size_t out_of_sample_bars = 0;
+    bool anchored = false;
 };
 
 struct TradeData {
@@ -52,6 +86,7 @@ struct BacktestResults {
     double sharpe_ratio;
     double max_drawdown;
     double win_rate;
+    double total_costs;
     std::vector<TradeData> trades;
     std::vector<EquityPoint> equity_curve;
 };
@@ -76,6 +111,14 @@ struct Job {
     std::chrono::system_clock::time_point completed_at;
     double progress;
     std::string current_step;
+    // Sweep jobs only: what to evaluate, and the metrics of every point once completed
+    std::shared_ptr<const SweepRequest> sweep;
+    std::shared_ptr<const SweepResult> sweep_result;
+    // Walk-forward jobs only: the folds, and their per-fold results once completed
+    std::shared_ptr<const WalkForwardRequest> walk_forward;
+    std::shared_ptr<const WalkForwardResult> walk_forward_result;
+    // Stops a running sweep or walk-forward analysis between chunks of points
+    std::atomic<bool> cancel_requested{false};
     
     Job() : status(JobStatus::PENDING), progress(0.0) {
         created_at = std::chrono::system_clock::now();
@@ -87,17 +130,29 @@ using ProgressCallback = std::function<void(const std::string&, double, const st
 
 class JobManager {
 public:
-    JobManager(size_t max_concurrent_jobs = 4);
+    JobManager(size_t max_concurrent_jobs = 4,
+               size_t dataset_cache_bytes = DatasetCache::kDefaultByteBudget,
+               size_t indicator_cache_bytes = IndicatorCache::kDefaultByteBudget);
     ~JobManager();
 
     // Job submission and management
     std::string submitJob(const BacktestRequest& request);
+    // Queues a parameter sweep; its points run in parallel over one load of the data.
+    // Throws std::invalid_argument for an invalid grid.
+    std::string submitSweep(const SweepRequest& request);
+    // Queues a walk-forward analysis; the job's results are its stitched out-of-sample run.
+    // Throws std::invalid_argument for an invalid grid or empty windows.
+    std::string submitWalkForward(const WalkForwardRequest& request);
     bool cancelJob(const std::string& job_id);
     JobPtr getJob(const std::string& job_id);
     
     // Job status and results
     JobStatusResponse getJobStatus(const std::string& job_id);
     BacktestResults getJobResults(const std::string& job_id);
+    // Metrics table and top points of a completed sweep job; null otherwise.
+    std::shared_ptr<const SweepResult> getSweepResults(const std::string& job_id);
+    // Folds of a completed walk-forward job; null otherwise.
+    std::shared_ptr<const WalkForwardResult> getWalkForwardResults(const std::string& job_id);
     
     // Progress tracking
     void setProgressCallback(ProgressCallback callback);
@@ -112,6 +167,14 @@ public:
     // Cleanup
     void cleanupCompletedJobs(std::chrono::hours max_age = std::chrono::hours(24));
 
+    // Shared market data cache (hit/miss/eviction counters, memory use)
+    DatasetCacheStats getDatasetCacheStats() const;
+    DatasetCache& getDatasetCache() { return *dataset_cache_; }
+
+    // Indicator columns shared by jobs over the same bars (e.g. the runs of a sweep)
+    IndicatorCacheStats getIndicatorCacheStats() const;
+    IndicatorCache& getIndicatorCache() { return *indicator_cache_; }
+
 private:
     // Worker thread function
     void workerThread();
@@ -119,10 +182,20 @@ private:
     // Job execution
     void executeJob(JobPtr job);
     BacktestResults runBacktest(const BacktestRequest& request, JobPtr job);
+    std::shared_ptr<const SweepResult> runSweep(const SweepRequest& request, JobPtr job);
+    std::shared_ptr<const WalkForwardResult> runWalkForward(const WalkForwardRequest& request, JobPtr job);
+    static BacktestResults convertResult(const std::string& job_id, const BacktestResult& engine_result);
+    // The request's bars, windowed; `market_data` keeps them alive and `dataset_key`
+    // is set to their indicator cache key, or left empty when they are not cached.
+    MarketDataView loadData(const BacktestRequest& request,
+                            std::shared_ptr<const MarketData>& market_data,
+                            std::string& dataset_key);
+    std::shared_ptr<const MarketData> loadFromDatabase(const BacktestRequest& request);
     
     // Internal job management
     void markJobRunning(JobPtr job);
     void markJobCompleted(JobPtr job, const BacktestResults& result);
+    void markJobCancelled(JobPtr job);
     void markJobFailed(JobPtr job, const std::string& error);
     
     // Thread-safe operations
@@ -145,6 +218,13 @@ private:
     std::atomic<size_t> running_jobs_count_;
     
     ProgressCallback progress_callback_;
+
+    // Datasets shared by all jobs; one copy per file no matter how many jobs use it
+    std::unique_ptr<DatasetCache> dataset_cache_;
+    // Indicators computed over those datasets, keyed by dataset version and window
+    std::unique_ptr<IndicatorCache> indicator_cache_;
+    // One engine for all jobs; each run works on its own strategy instance
+    std::unique_ptr<BacktestEngine> engine_;
     
     // Job ID generation
     std::atomic<uint64_t> job_counter_;
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace fingraph {
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The mapping is shared through the OS page cache, so several jobs (or processes)
+ * mapping the same file do not each hold a private copy of it.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Maps the file read-only. Returns false if it cannot be opened or mapped.
+    bool open(const std::string& filePath);
+    void close();
+
+    bool isOpen() const { return data_ != nullptr || isEmptyFile_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    std::string_view view() const { return std::string_view(data_, size_); }
+
+    // Hints the kernel that the mapping will be read front to back.
+    void adviseSequential() const;
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool isEmptyFile_ = false;
+};
+
+} // namespace fingraph
@@ -1,8 +1,13 @@
 #pragma once
+#include "fingraph/AlignedAllocator.h"
 #include <string>
+#include <string_view>
 #include <vector>
-#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <chrono>
+#include <cstdint>
 
 namespace fingraph {
 
@@ -15,20 +20,197 @@ struct OHLCV {
     uint64_t volume;
 };
 
+// Bar timestamps are stored in columns as whole seconds since the Unix epoch (UTC).
+inline std::chrono::system_clock::time_point toTimePoint(int64_t epochSeconds) {
+    return std::chrono::system_clock::time_point(std::chrono::seconds(epochSeconds));
+}
+
+inline int64_t toEpochSeconds(const std::chrono::system_clock::time_point& tp) {
+    return std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch()).count();
+}
+
+struct LoadError {
+    size_t line;         // 1-based line number in the source file
+    std::string message;
+};
+
+// Summary of a load: malformed rows are counted, and only the first few are kept verbatim.
+struct LoadReport {
+    static constexpr size_t kMaxReportedErrors = 32;
+
+    size_t rowsLoaded = 0;
+    size_t rowsRejected = 0;
+    std::vector<LoadError> errors;
+
+    void addError(size_t line, std::string_view reason, std::string_view text);
+    void merge(const LoadReport& other);
+};
+
+// Growable struct-of-arrays bar storage; each column is 64-byte aligned.
+struct ColumnBuffers {
+    AlignedVector<int64_t> timestamps;
+    AlignedVector<double> open;
+    AlignedVector<double> high;
+    AlignedVector<double> low;
+    AlignedVector<double> close;
+    AlignedVector<uint64_t> volume;
+
+    size_t size() const { return timestamps.size(); }
+    void reserve(size_t n);
+    void clear();
+    // Drops the first `n` rows, keeping capacity (used to slide a window forward).
+    void eraseFront(size_t n);
+
+    void append(int64_t epochSeconds, double o, double h, double l, double c, uint64_t v) {
+        timestamps.push_back(epochSeconds);
+        open.push_back(o);
+        high.push_back(h);
+        low.push_back(l);
+        close.push_back(c);
+        volume.push_back(v);
+    }
+
+    void append(const OHLCV& bar) {
+        append(toEpochSeconds(bar.timestamp), bar.open, bar.high, bar.low, bar.close, bar.volume);
+    }
+};
+
+/**
+ * @class MarketDataView
+ * @brief Non-owning, read-only view of a run of bars, one contiguous span per column.
+ *
+ * Views are cheap to copy and are what strategies and the backtest loop consume.
+ * They stay valid for as long as the MarketData they were taken from. Timestamps
+ * are expected in ascending order, which is what the time lookups rely on.
+ */
+class MarketDataView {
+public:
+    MarketDataView() = default;
+    explicit MarketDataView(const ColumnBuffers& columns);
+    MarketDataView(const int64_t* timestamps, const double* open, const double* high,
+                   const double* low, const double* close, const uint64_t* volume, size_t size)
+        : timestamps_(timestamps), open_(open), high_(high), low_(low), close_(close),
+          volume_(volume), size_(size) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    std::span<const int64_t> getTimestamps() const { return {timestamps_, size_}; }
+    std::span<const double> getOpens() const { return {open_, size_}; }
+    std::span<const double> getHighs() const { return {high_, size_}; }
+    std::span<const double> getLows() const { return {low_, size_}; }
+    std::span<const double> getCloses() const { return {close_, size_}; }
+    std::span<const uint64_t> getVolumes() const { return {volume_, size_}; }
+
+    // Reassembles a single bar (row) from the columns.
+    OHLCV getBar(size_t index) const {
+        return {toTimePoint(timestamps_[index]), open_[index], high_[index], low_[index],
+                close_[index], volume_[index]};
+    }
+
+    // Bars [begin, begin + count), clamped to this view. No data is copied.
+    MarketDataView slice(size_t begin, size_t count) const;
+
+    // Index of the first bar at or after / strictly after `epochSeconds`.
+    size_t lowerBound(int64_t epochSeconds) const;
+    size_t upperBound(int64_t epochSeconds) const;
+
+    // Bars with start <= timestamp <= end. No data is copied.
+    MarketDataView sliceByTime(const std::chrono::system_clock::time_point& start,
+                               const std::chrono::system_clock::time_point& end) const;
+
+private:
+    const int64_t* timestamps_ = nullptr;
+    const double* open_ = nullptr;
+    const double* high_ = nullptr;
+    const double* low_ = nullptr;
+    const double* close_ = nullptr;
+    const uint64_t* volume_ = nullptr;
+    size_t size_ = 0;
+};
+
+// How the columns of a .fgc cache are stored on disk.
+enum class CacheEncoding : uint32_t {
+    Raw = 0,     // Plain arrays, memory-mapped and used in place
+    Gorilla = 1, // Compressed blocks (see GorillaCodec), decoded into memory on load
+};
+
+struct CsvLoadOptions {
+    // Reuse (and refresh) the .fgc binary cache stored beside the CSV file.
+    bool useBinaryCache = true;
+    // Encoding used when the cache is (re)written; either kind is read back.
+    CacheEncoding cacheEncoding = CacheEncoding::Raw;
+    // Threads used to parse the CSV: 0 uses every core, 1 parses serially.
+    size_t parseThreads = 0;
+    // Smaller files are parsed serially; splitting them costs more than it saves.
+    size_t parallelMinBytes = size_t(32) << 20;
+};
+
+/**
+ * @class MarketData
+ * @brief A time-ordered series of bars stored column-wise (struct-of-arrays).
+ *
+ * Loaded columns are immutable and shared between copies, so copying a MarketData
+ * is cheap. The columns live either in heap buffers or directly in a memory-mapped
+ * .fgc cache file. getData() remains available as an array-of-structs
+ * compatibility layer; it is materialized on first use only.
+ */
 class MarketData {
 public:
     MarketData() = default;
     ~MarketData() = default;
-    
-    bool loadFromCSV(const std::string& filePath);
+
+    bool loadFromCSV(const std::string& filePath, const CsvLoadOptions& options = {});
+
+    // Replaces the contents with already-parsed columns.
+    void assign(ColumnBuffers&& columns);
+    // Replaces the contents with columns owned by `storage` (e.g. a mapped file).
+    void assign(std::shared_ptr<const void> storage, const MarketDataView& view);
+
+    // Returns these bars aggregated to `barSeconds`-long bars (see Resampler).
+    MarketData resample(int64_t barSeconds) const;
+
+    size_t size() const { return view_.size(); }
+    bool empty() const { return view_.empty(); }
+    const MarketDataView& getView() const { return view_; }
+
+    // Bytes held by the columns (heap or mapped), used for cache budgeting.
+    size_t getMemoryUsage() const {
+        return size() * (sizeof(int64_t) + 4 * sizeof(double) + sizeof(uint64_t));
+    }
+
+    std::span<const int64_t> getTimestamps() const { return view_.getTimestamps(); }
+    std::span<const double> getOpens() const { return view_.getOpens(); }
+    std::span<const double> getHighs() const { return view_.getHighs(); }
+    std::span<const double> getLows() const { return view_.getLows(); }
+    std::span<const double> getCloses() const { return view_.getCloses(); }
+    std::span<const uint64_t> getVolumes() const { return view_.getVolumes(); }
+
     const std::vector<OHLCV>& getData() const;
     std::vector<OHLCV> getDataInRange(
         const std::chrono::system_clock::time_point& start,
         const std::chrono::system_clock::time_point& end) const;
-    
+    // Zero-copy variant of getDataInRange.
+    MarketDataView getViewInRange(
+        const std::chrono::system_clock::time_point& start,
+        const std::chrono::system_clock::time_point& end) const {
+        return view_.sliceByTime(start, end);
+    }
+
+    // Row counts and the first malformed rows of the most recent load.
+    const LoadReport& getLoadReport() const { return loadReport_; }
+
 private:
-    std::vector<OHLCV> data_;
-    std::map<std::chrono::system_clock::time_point, size_t> timestampIndex_;
+    // Lazily built array-of-structs copy backing getData().
+    struct RowCache {
+        std::once_flag once;
+        std::vector<OHLCV> rows;
+    };
+
+    std::shared_ptr<const void> storage_; // Owns the memory view_ points into
+    MarketDataView view_;
+    std::shared_ptr<RowCache> rowCache_;
+    LoadReport loadReport_;
 };
 
-} 
\ No newline at end of file
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "fingraph/MarketData.h"
+#include <memory>
+#include <string>
+
+namespace fingraph {
+
+struct MarketDataStreamOptions {
+    // Source bytes read per block: CSV text or raw .fgc columns. Compressed caches
+    // are read in the blocks they were written with.
+    size_t blockBytes = size_t(8) << 20;
+    // Read the .fgc cache beside the CSV instead when it is current.
+    bool useBinaryCache = true;
+};
+
+/**
+ * @class MarketDataStream
+ * @brief Reads a market data file front to back in fixed-size blocks.
+ *
+ * Unlike MarketData, which holds a whole series, a stream keeps only one block
+ * of source data in memory at a time, so files larger than RAM can be processed
+ * with a bounded footprint. Streams only read: one that reads CSV text does not
+ * write a .fgc cache.
+ */
+class MarketDataStream {
+public:
+    virtual ~MarketDataStream() = default;
+
+    /**
+     * @brief Opens `filePath`, or its .fgc cache if that was built from the current file.
+     * @return nullptr if the file cannot be opened.
+     */
+    static std::unique_ptr<MarketDataStream> open(const std::string& filePath,
+                                                  const MarketDataStreamOptions& options = {});
+
+    /**
+     * @brief Appends the next block of bars to `out`.
+     * @return The number of bars appended; 0 once the data is exhausted.
+     */
+    virtual size_t read(ColumnBuffers& out) = 0;
+
+    // Rows read (and rejected) so far.
+    const LoadReport& getLoadReport() const { return report_; }
+
+protected:
+    LoadReport report_;
+};
+
+} // namespace fingraph
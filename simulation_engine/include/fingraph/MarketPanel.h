@@ -0,0 +1,84 @@
+#pragma once
+#include "fingraph/AlignedAllocator.h"
+#include "fingraph/MarketData.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace fingraph {
+
+/**
+ * @class MarketPanel
+ * @brief Several symbols' bars aligned on one shared timestamp axis.
+ *
+ * The axis is the sorted union of every symbol's timestamps. For each symbol the
+ * panel keeps, per axis position, whether the symbol has a bar there and the index
+ * of its latest bar at or before it. Price fields are materialized lazily, on
+ * first access, as a symbol x time matrix with one contiguous, forward-filled row
+ * per symbol (NaN before a symbol's first bar); volumes are 0 where a symbol has no
+ * bar. The source series are shared, not copied.
+ */
+class MarketPanel {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+    // getFillIndex() value before a symbol's first bar.
+    static constexpr uint32_t kNoBar = std::numeric_limits<uint32_t>::max();
+
+    MarketPanel() = default;
+
+    // Loads one CSV file per symbol, in parallel. Returns false if any file fails to load.
+    bool loadFromCSV(const std::vector<std::string>& symbols, const std::vector<std::string>& filePaths,
+                     const CsvLoadOptions& options = {});
+
+    // Aligns already-loaded series (e.g. shared from a DatasetCache), one per symbol.
+    void assign(std::vector<std::string> symbols, std::vector<std::shared_ptr<const MarketData>> series);
+
+    size_t getSymbolCount() const { return symbols_.size(); }
+    size_t size() const { return timestamps_.size(); } // Length of the shared axis
+    const std::vector<std::string>& getSymbols() const { return symbols_; }
+    size_t findSymbol(const std::string& symbol) const; // npos if absent
+    const MarketData& getSeries(size_t symbol) const { return *series_[symbol]; }
+
+    std::span<const int64_t> getTimestamps() const { return {timestamps_.data(), timestamps_.size()}; }
+    // 1 where the symbol has a bar at that axis position, 0 where it is filled.
+    std::span<const uint8_t> getPresentMask(size_t symbol) const { return row(present_, symbol); }
+    // Index into getSeries(symbol) of the bar in effect at each axis position.
+    std::span<const uint32_t> getFillIndex(size_t symbol) const { return row(fillIndex_, symbol); }
+
+    std::span<const double> getOpens(size_t symbol) const { return row(field(kOpen), symbol); }
+    std::span<const double> getHighs(size_t symbol) const { return row(field(kHigh), symbol); }
+    std::span<const double> getLows(size_t symbol) const { return row(field(kLow), symbol); }
+    std::span<const double> getCloses(size_t symbol) const { return row(field(kClose), symbol); }
+    std::span<const uint64_t> getVolumes(size_t symbol) const;
+
+private:
+    enum PriceField { kOpen, kHigh, kLow, kClose, kPriceFieldCount };
+
+    // A symbol x time matrix filled on first use; shared by copies of the panel.
+    template <typename T>
+    struct LazyMatrix {
+        std::once_flag once;
+        AlignedVector<T> values;
+    };
+
+    template <typename T>
+    std::span<const T> row(const AlignedVector<T>& matrix, size_t symbol) const {
+        return {matrix.data() + symbol * size(), size()};
+    }
+
+    const AlignedVector<double>& field(PriceField which) const;
+
+    std::vector<std::string> symbols_;
+    std::vector<std::shared_ptr<const MarketData>> series_;
+    AlignedVector<int64_t> timestamps_;
+    AlignedVector<uint8_t> present_;    // symbol x time
+    AlignedVector<uint32_t> fillIndex_; // symbol x time
+    std::shared_ptr<LazyMatrix<double>> prices_[kPriceFieldCount];
+    std::shared_ptr<LazyMatrix<uint64_t>> volumes_;
+};
+
+} // namespace fingraph
@@ -0,0 +1,139 @@
+#pragma once
+#include "fingraph/SymbolTable.h"
+#include "fingraph/Trade.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace fingraph {
+
+using OrderId = uint64_t;
+
+enum class OrderType : uint8_t { MARKET, LIMIT, STOP, TRAILING_STOP };
+
+struct Order {
+    SymbolId symbol = 0;
+    TradeType side = TradeType::BUY;
+    OrderType type = OrderType::MARKET;
+    double quantity = 0.0;
+    // LIMIT: the limit price. STOP: the stop price. TRAILING_STOP: the reference
+    // price the trail starts from (typically the entry). Unused for MARKET.
+    double price = 0.0;
+    // TRAILING_STOP only: distance of the stop from the best price since placement.
+    double trail = 0.0;
+};
+
+struct Fill {
+    OrderId order;
+    SymbolId symbol;
+    TradeType side;
+    double quantity;
+    double price;
+    OrderType type;
+    double orderPrice; // The order's own price (see Order::price)
+};
+
+/**
+ * @class OrderBook
+ * @brief Resting orders per symbol, indexed by trigger price so each bar costs O(log n + fills).
+ *
+ * processBar() checks a symbol's orders against one bar's open, high and low:
+ *   - MARKET fills at the open.
+ *   - BUY LIMIT and SELL STOP trigger when the low reaches the price.
+ *   - SELL LIMIT and BUY STOP trigger when the high reaches it.
+ *   - A SELL TRAILING_STOP triggers when the low falls `trail` below the highest
+ *     high since placement (at least the reference price); a BUY one when the high
+ *     rises `trail` above the lowest low.
+ * Triggered orders fill at their price, or at the open when the bar gapped through
+ * it. Within a bar, market orders fill first, then those triggered by the low,
+ * then those triggered by the high, so a stop-loss wins over a take-profit hit in
+ * the same bar. Trailing stops ratchet after the bar is checked: a bar's own high
+ * (or low) never moves the stop it is checked against.
+ *
+ * Orders that trigger at the low are kept in a max-heap of prices and those that
+ * trigger at the high in a min-heap, so a bar pops exactly the orders it crosses.
+ * Trailing stops are grouped in buckets sharing the same extreme; a new high
+ * merges every bucket below it into one. Cancelled orders are dropped lazily.
+ */
+class OrderBook {
+public:
+    // Validates and rests `order`; throws std::invalid_argument for a non-positive
+    // quantity, a non-positive or non-finite price, or a trailing stop without a trail.
+    OrderId place(const Order& order);
+    // Returns false if the order is not resting (filled, cancelled or unknown).
+    bool cancel(OrderId id);
+
+    // Fills the symbol's orders that `open`, `high` and `low` trigger, appending to `fills`.
+    void processBar(SymbolId symbol, double open, double high, double low, std::vector<Fill>& fills);
+
+    // The resting order, or null.
+    const Order* find(OrderId id) const;
+    bool hasOrders(SymbolId symbol) const { return symbol < books_.size() && books_[symbol].resting > 0; }
+    size_t size() const { return resting_.size(); }
+
+private:
+    struct Entry {
+        double key;
+        OrderId id;
+    };
+
+    struct TrailingBucket {
+        std::vector<Entry> byTrail; // Min-heap of trails
+        uint64_t version = 0;
+    };
+
+    using BucketMap = std::map<double, TrailingBucket>;
+
+    struct BucketStop {
+        double stop;
+        double extreme;
+        uint64_t version;
+    };
+
+    // One direction of a symbol's book, in prices mirrored so that every order
+    // triggers when the bar's (mirrored) extreme x falls to its key: x = low for
+    // orders triggered by the low, x = -high (and keys negated) for those
+    // triggered by the high.
+    struct Side {
+        std::vector<Entry> fixed;                   // Limits and stops: max-heap of trigger prices
+        BucketMap trailing;                         // By extreme since placement
+        std::vector<BucketStop> bucketStops;        // Max-heap of each bucket's highest stop
+        uint64_t versions = 0;
+        size_t cancelled = 0;
+    };
+
+    struct SymbolBook {
+        std::vector<OrderId> market;
+        Side low;  // Triggered by the low
+        Side high; // Triggered by the high, mirrored
+        size_t resting = 0;
+    };
+
+    // Cancelled entries tolerated per symbol before its heaps are rebuilt.
+    static constexpr size_t kCompactThreshold = 64;
+
+    bool isResting(OrderId id) const { return resting_.count(id) != 0; }
+    SymbolBook& getBook(SymbolId symbol);
+    // The side an order rests on; `mirrored` is set for the side triggered by the high.
+    static Side& getSide(SymbolBook& book, const Order& order, bool& mirrored);
+    // Fills the orders of `side` triggered at `x` (mirrored prices throughout);
+    // `sign` maps them back to real prices.
+    void fillSide(Side& side, double open, double x, double sign, std::vector<Fill>& fills);
+    void fill(OrderId id, double price, std::vector<Fill>& fills);
+    // Raises every trailing extreme below `extreme` to it, merging the buckets.
+    void ratchet(Side& side, double extreme);
+    // Drops cancelled orders from the top of the bucket, then re-publishes its
+    // highest stop, or erases the bucket if it is empty.
+    void refreshBucket(Side& side, BucketMap::iterator bucket);
+    // Rebuilds the heaps without cancelled entries once they make up much of the book.
+    void compact(SymbolBook& book);
+    void compact(Side& side);
+
+    std::unordered_map<OrderId, Order> resting_;
+    std::vector<SymbolBook> books_; // Indexed by SymbolId
+    OrderId nextId_ = 1;
+};
+
+} // namespace fingraph
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "fingraph/Backtest.h"
+#include "fingraph/ThreadPool.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace fingraph {
+
+// One swept parameter and the values it takes.
+struct ParameterAxis {
+    std::string name;
+    std::vector<double> values;
+
+    // start, start + step, ... up to and including `stop` (within rounding);
+    // throws std::invalid_argument for a non-positive step or stop < start.
+    static ParameterAxis range(std::string name, double start, double stop, double step);
+};
+
+/**
+ * @class ParameterGrid
+ * @brief The cartesian product of parameter axes on top of fixed parameters.
+ *
+ * Points are numbered in odometer order, the last axis varying fastest, so a
+ * point is decoded from its index alone and the grid is never materialized.
+ */
+class ParameterGrid {
+public:
+    ParameterGrid() = default;
+    // Throws std::invalid_argument for an empty axis or a name used twice.
+    explicit ParameterGrid(std::vector<ParameterAxis> axes, std::map<std::string, double> fixed = {});
+
+    // Number of points: the product of the axis lengths (1 without axes).
+    size_t size() const { return size_; }
+    const std::vector<ParameterAxis>& getAxes() const { return axes_; }
+    const std::map<std::string, double>& getFixed() const { return fixed_; }
+
+    // The position along axis `axis` of point `index`, and the value there.
+    size_t getAxisIndex(size_t index, size_t axis) const {
+        return (index / strides_[axis]) % axes_[axis].values.size();
+    }
+    double getValue(size_t index, size_t axis) const { return axes_[axis].values[getAxisIndex(index, axis)]; }
+    // The point at the given position along each axis.
+    size_t getIndex(const std::vector<size_t>& axisIndices) const;
+    // Writes the parameters of point `index` into `params`: the fixed ones, then
+    // each axis' value. Reusing `params` across points reuses its nodes.
+    void getPoint(size_t index, std::map<std::string, double>& params) const;
+
+private:
+    std::vector<ParameterAxis> axes_;
+    std::map<std::string, double> fixed_;
+    std::vector<size_t> strides_; // Points per step of each axis
+    size_t size_ = 1;
+};
+
+enum class SweepMetric { TOTAL_RETURN, SHARPE_RATIO, MAX_DRAWDOWN, WIN_RATE };
+
+// Parses "total_return", "sharpe_ratio", "max_drawdown" or "win_rate";
+// throws std::invalid_argument otherwise.
+SweepMetric sweepMetricFromString(const std::string& name);
+
+// The metrics of the evaluated grid points, one column per metric and one row
+// per point. Points that failed hold NaN metrics and no trades.
+struct SweepTable {
+    std::vector<double> totalReturn;
+    std::vector<double> sharpeRatio;
+    std::vector<double> maxDrawdown;
+    std::vector<double> winRate;
+    std::vector<double> totalCosts;
+    std::vector<uint32_t> tradeCount;
+
+    size_t size() const { return totalReturn.size(); }
+    void resize(size_t rows);
+    const std::vector<double>& getColumn(SweepMetric metric) const;
+};
+
+struct SweepResult {
+    ParameterGrid grid;
+    SweepTable table;
+    // Grid point of each table row; empty when the table covers the whole grid in order.
+    std::vector<size_t> rows;
+    // Table rows of the best points by the chosen metric, best first; ties go to the lower row.
+    std::vector<size_t> top;
+    size_t evaluated = 0;    // Backtests run, failed ones included; a search counts every rung
+    size_t barsExecuted = 0; // Bars those backtests simulated
+    size_t failed = 0;       // Failed rows of the table
+    std::string firstError;  // Message of the lowest failed row
+    bool cancelled = false;
+
+    size_t getGridIndex(size_t row) const { return rows.empty() ? row : rows[row]; }
+};
+
+struct SweepOptions {
+    SweepMetric metric = SweepMetric::SHARPE_RATIO;
+    size_t topK = 10;
+    // Called from the thread running the sweep with the fraction of points done.
+    std::function<void(double)> onProgress;
+    // Polled between chunks of points; once set, the remaining points are skipped.
+    const std::atomic<bool>* cancelled = nullptr;
+};
+
+enum class SweepMode { GRID, SUCCESSIVE_HALVING, GENETIC };
+
+// Parses "grid", "successive_halving" or "genetic"; throws std::invalid_argument otherwise.
+SweepMode sweepModeFromString(const std::string& name);
+
+struct SuccessiveHalvingOptions {
+    // Grid points drawn at random for the first rung; 0 starts from every point.
+    size_t candidates = 0;
+    // Slices of history, growing by `eta` from rung to rung; the last is all of it.
+    size_t rungs = 4;
+    // Each rung keeps the best 1/eta of its candidates.
+    double eta = 3.0;
+    uint64_t seed = 1;
+};
+
+// The defaults favour speed over finding the grid's exact best point (see runGenetic()).
+struct GeneticOptions {
+    size_t population = 32;
+    size_t generations = 20;
+    // Best points carried over unchanged into each generation.
+    size_t elite = 2;
+    // Chance that each gene (axis position) of a child mutates.
+    double mutationRate = 0.25;
+    uint64_t seed = 1;
+};
+
+/**
+ * @class ParameterSweep
+ * @brief Evaluates the points of a ParameterGrid over one dataset on a thread pool.
+ *
+ * The bars are shared by all points, and with an indicator cache on the engine and
+ * a dataset key, so is every indicator: each distinct one is computed once for the
+ * whole sweep. Workers claim chunks of consecutive points from an atomic counter,
+ * write their metrics straight into the table's rows and keep a bounded min-heap of
+ * their best points, merged once at the end, so nothing is locked per point.
+ * MAX_DRAWDOWN ranks lower values first, the other metrics higher ones.
+ *
+ * Besides the exhaustive run(), two searches look for the best points of the grid
+ * while running far fewer bars; SweepResult::barsExecuted reports how many:
+ *   - runSuccessiveHalving() evaluates candidates on a short prefix of the history,
+ *     keeps the best 1/eta of them for a prefix eta times longer, and so on up to
+ *     the full history. Each candidate's prefix is extended by its own lookback, so
+ *     all of them trade over about the same number of bars whatever their warm-up.
+ *   - runGenetic() evolves a population of grid positions over the full history by
+ *     tournament selection, uniform crossover and mutation steps along each axis
+ *     that shrink from one generation to the next; no point is evaluated twice.
+ *     It is the cheaper, lower-quality mode: it runs a small fraction of the
+ *     grid's points and usually finds one near the top of the grid, but unlike
+ *     run() it is not expected to return the grid's best point when the leaders
+ *     are close. Larger populations and more generations buy quality with bars.
+ * Both are seeded and deterministic, and their table holds the points of the last
+ * rung, or every point the genetic search evaluated.
+ *
+ * Every run blocks on the pool and so must not be called from one of its tasks.
+ */
+class ParameterSweep {
+public:
+    explicit ParameterSweep(BacktestEngine& engine, ThreadPool& pool = ThreadPool::shared());
+
+    SweepResult run(const MarketDataView& data,
+                    const std::string& strategyName,
+                    const ParameterGrid& grid,
+                    double initialCash,
+                    const SweepOptions& options = {},
+                    const std::string& datasetKey = {});
+
+    // Evaluates only the grid points `rows`; table row i holds point rows[i].
+    SweepResult run(const MarketDataView& data,
+                    const std::string& strategyName,
+                    const ParameterGrid& grid,
+                    std::vector<size_t> rows,
+                    double initialCash,
+                    const SweepOptions& options = {},
+                    const std::string& datasetKey = {});
+
+    // Throws std::invalid_argument for fewer than one rung or an eta not above 1.
+    SweepResult runSuccessiveHalving(const MarketDataView& data,
+                                     const std::string& strategyName,
+                                     const ParameterGrid& grid,
+                                     double initialCash,
+                                     const SweepOptions& options,
+                                     const SuccessiveHalvingOptions& halving,
+                                     const std::string& datasetKey = {});
+
+    // Throws std::invalid_argument for an empty population.
+    SweepResult runGenetic(const MarketDataView& data,
+                           const std::string& strategyName,
+                           const ParameterGrid& grid,
+                           double initialCash,
+                           const SweepOptions& options,
+                           const GeneticOptions& genetic,
+                           const std::string& datasetKey = {});
+
+private:
+    // Most points a worker claims at a time; small sweeps use smaller chunks.
+    static constexpr size_t kChunkSize = 64;
+
+    // Evaluates the points `rows`, or the whole grid when null. With `lengths`,
+    // point rows[i] runs over the first lengths[i] bars only.
+    SweepResult evaluate(const MarketDataView& data, const std::string& strategyName,
+                         const ParameterGrid& grid, const std::vector<size_t>* rows,
+                         const std::vector<size_t>* lengths, double initialCash,
+                         const SweepOptions& options, const std::string& datasetKey);
+
+    BacktestEngine& engine_;
+    ThreadPool& pool_;
+};
+
+} // namespace fingraph
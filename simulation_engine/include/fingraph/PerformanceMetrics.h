@@ -1,11 +1,12 @@
 #pragma once
 #include <vector>
 #include <chrono>
+#include <cstddef>
 
 namespace fingraph {
 
 // Forward declaration to avoid including Portfolio.h
-class Trade; 
+class TradeLog;
 
 class PerformanceMetrics {
 public:
@@ -19,11 +20,34 @@ public:
         const std::vector<std::pair<std::chrono::system_clock::time_point, double> >& equityCurve);
 
     // Calculates the percentage of profitable trades.
-    static double calculateWinRate(const std::vector<Trade>& trades);
+    static double calculateWinRate(const TradeLog& trades);
 
     // Calculates the total return of the backtest.
     static double calculateTotalReturn(
         const std::vector<std::pair<std::chrono::system_clock::time_point, double> >& equityCurve);
 };
 
+// Computes the equity-curve metrics above one value at a time, in constant memory,
+// for backtests whose curve is too long to keep. The Sharpe ratio uses a running
+// (Welford) variance, so it can differ from the batch one in the last few digits.
+class EquityCurveAccumulator {
+public:
+    void add(double value);
+
+    double getTotalReturn() const;
+    double getMaxDrawdown() const { return maxDrawdown_; }
+    double getSharpeRatio(double riskFreeRate = 0.0) const;
+
+private:
+    size_t count_ = 0;
+    double first_ = 0.0;
+    double last_ = 0.0;
+    double peak_ = 0.0;
+    double maxDrawdown_ = 0.0;
+    // Running mean and sum of squared deviations of the per-bar returns
+    size_t returnCount_ = 0;
+    double meanReturn_ = 0.0;
+    double squaredDeviations_ = 0.0;
+};
+
 } // namespace fingraph
\ No newline at end of file
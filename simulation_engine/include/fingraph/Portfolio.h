@@ -1,34 +1,99 @@
 #pragma once
+#include "fingraph/SymbolTable.h"
 #include "fingraph/Trade.h"
+#include "fingraph/TradeLog.h"
+#include <cstddef>
+#include <span>
 #include <vector>
 #include <map>
 #include <string>
+#include <utility>
 
 namespace fingraph {
 
+/**
+ * @class Portfolio
+ * @brief Cash plus positions in any number of symbols, held in flat arrays indexed by SymbolId.
+ *
+ * Besides the quantities, the portfolio keeps each symbol's last price and the
+ * resulting mark-to-market value, updated incrementally: a price update or a
+ * trade costs O(1) and allocates nothing, so a bar over hundreds of symbols costs
+ * only as much as the prices and positions that changed. The running value is
+ * compensated and is recomputed exactly every kResyncInterval updates.
+ * The string-keyed methods remain for callers that value with their own prices.
+ */
 class Portfolio {
 public:
+    // Price updates and trades between exact recomputations of the market value.
+    static constexpr size_t kResyncInterval = size_t(1) << 16;
+
     explicit Portfolio(double initialCash);
 
-    // Executes a trade, updating cash and positions.
+    // Executes a trade, updating cash and positions; the symbol is marked at the
+    // trade price. Throws std::runtime_error for a buy beyond the cash or a sell
+    // beyond the position.
     void addTrade(const Trade& trade);
+    // As above, for a symbol already interned here (std::out_of_range otherwise),
+    // also paying `commission` from cash; a buy must cover it too.
+    void addTrade(const TradeRecord& trade, double commission = 0.0);
 
     double getCash() const { return cash_; }
+    // Total commission paid.
+    double getCommissions() const { return commissions_; }
     // Returns the quantity of shares held for a given symbol.
     double getPosition(const std::string& symbol) const;
-    
+
     // Calculates the total value of all held positions at current market prices.
     double getEquityValue(const std::map<std::string, double>& currentPrices) const;
-    
+
     // Total portfolio value = cash + equity value.
     double getTotalValue(const std::map<std::string, double>& currentPrices) const;
-    
-    const std::vector<Trade>& getTrades() const { return trades_; }
+
+    // Dense interface. Ids come from the portfolio's own symbol table.
+    SymbolId internSymbol(const std::string& symbol);
+    const SymbolTable& getSymbols() const { return symbols_; }
+    double getPosition(SymbolId symbol) const { return symbol < positions_.size() ? positions_[symbol] : 0.0; }
+    double getPrice(SymbolId symbol) const { return symbol < prices_.size() ? prices_[symbol] : 0.0; }
+    // Marks `symbol` at `price`. NaN (no bar yet) leaves the last price in place.
+    // Throws std::out_of_range for an id this portfolio has not interned.
+    void updatePrice(SymbolId symbol, double price);
+    // Marks symbols[i] at prices[i] for each i; the spans must have equal length.
+    void updatePrices(std::span<const SymbolId> symbols, std::span<const double> prices);
+    // Marks symbol i at prices[i] for i < prices.size() (e.g. one MarketPanel column).
+    void updatePrices(std::span<const double> prices);
+    // Sum of position * last price over the held symbols.
+    double getMarketValue() const { return marketValue_ + marketValueCompensation_; }
+    // Cash plus the market value.
+    double getTotalValue() const { return cash_ + getMarketValue(); }
+    // Symbols with a non-zero position, in no particular order.
+    std::span<const SymbolId> getHeldSymbols() const { return heldSymbols_; }
+
+    // Executed trades, in order; symbols are ids in getSymbols().
+    const TradeLog& getTrades() const { return trades_; }
+    // Moves the log out, leaving this portfolio's empty.
+    TradeLog takeTrades() { return std::move(trades_); }
 
 private:
+    static constexpr uint32_t kNotHeld = SymbolTable::kNotFound;
+
+    void ensureSymbol(SymbolId symbol);
+    void setPosition(SymbolId symbol, double position);
+    // Adds `delta` to the running market value with Neumaier compensation.
+    void addToMarketValue(double delta);
+    void resyncMarketValue();
+
     double cash_;
-    // Maps a symbol (e.g., "AAPL") to the quantity of shares held.
-    std::map<std::string, double> positions_;
-    std::vector<Trade> trades_;
+    double commissions_ = 0.0;
+    SymbolTable symbols_;
+    // Indexed by SymbolId
+    std::vector<double> positions_;
+    std::vector<double> prices_;
+    std::vector<double> holdings_;       // positions_ * prices_, as added to the market value
+    std::vector<uint32_t> heldIndex_;    // Index into heldSymbols_, or kNotHeld
+    std::vector<SymbolId> heldSymbols_;
+    double marketValue_ = 0.0;
+    double marketValueCompensation_ = 0.0;
+    size_t updatesSinceResync_ = 0;
+    TradeLog trades_;
 };
-}
\ No newline at end of file
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "fingraph/MarketData.h"
+#include <cstdint>
+
+namespace fingraph {
+
+/**
+ * @class Resampler
+ * @brief Aggregates bars into coarser ones (e.g. 1-minute bars into hourly bars).
+ *
+ * Bars are grouped by the bucket `floor((timestamp - origin) / barSeconds)`; each
+ * group becomes one bar with the first open, highest high, lowest low, last close
+ * and summed volume, stamped with the bucket's start. Buckets without input bars
+ * produce no output. With the default origin, daily buckets are UTC days.
+ */
+class Resampler {
+public:
+    /**
+     * @brief Resamples time-ordered `data` into `out` (replacing its contents).
+     * @throws std::invalid_argument if barSeconds is not positive.
+     */
+    static void resample(const MarketDataView& data, int64_t barSeconds, ColumnBuffers& out,
+                         int64_t originSeconds = 0);
+};
+
+} // namespace fingraph
@@ -60,7 +60,8 @@ struct JobProgressUpdate {
 
 class SimulationEngineServer {
 public:
-    SimulationEngineServer(size_t max_concurrent_jobs = 4);
+    SimulationEngineServer(size_t max_concurrent_jobs = 4,
+                           size_t dataset_cache_bytes = DatasetCache::kDefaultByteBudget);
     ~SimulationEngineServer();
 
     // Server lifecycle
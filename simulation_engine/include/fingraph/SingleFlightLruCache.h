@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace fingraph {
+
+struct SingleFlightLruCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t failures = 0;
+    size_t entries = 0;
+    size_t bytes_in_use = 0;
+    size_t byte_budget = 0;
+};
+
+/**
+ * @class SingleFlightLruCache
+ * @brief Thread-safe string-keyed cache of immutable values, loaded once per key.
+ *
+ * Concurrent misses on one key are coalesced: the first caller runs the load
+ * outside the lock while the others wait on a shared future for its result, and
+ * a load that throws reaches every waiter and leaves nothing cached. Loaded
+ * entries are evicted least recently used first once their total size, as given
+ * by the size function, exceeds the byte budget. `Value` is meant to be a cheap
+ * handle such as a shared_ptr, so evicted values stay valid while referenced.
+ */
+template <typename Value>
+class SingleFlightLruCache {
+public:
+    using SizeFunction = std::function<size_t(const std::string& key, const Value& value)>;
+    // Called with the cache locked once `key` has loaded, before it is cached; may
+    // call evictLocked(). Returning false hands the value to its callers uncached.
+    using AdmitFunction = std::function<bool(const std::string& key)>;
+
+    SingleFlightLruCache(size_t byte_budget, SizeFunction size_of)
+        : size_of_(std::move(size_of)), byte_budget_(byte_budget) {
+    }
+
+    // Returns the value cached under `key`, running `load` on a miss.
+    Value get(const std::string& key, const std::function<Value()>& load, const AdmitFunction& admit = {}) {
+        std::promise<Value> promise;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            auto it = entries_.find(key);
+            if (it != entries_.end()) {
+                stats_.hits++;
+                Entry& entry = it->second;
+                if (entry.ready) {
+                    lru_.splice(lru_.begin(), lru_, entry.lru_position);
+                    return entry.value.get();
+                }
+                // Another caller is loading this key; wait for it outside the lock
+                std::shared_future<Value> pending = entry.value;
+                lock.unlock();
+                return pending.get();
+            }
+
+            stats_.misses++;
+            Entry entry;
+            entry.value = promise.get_future().share();
+            entries_.emplace(key, std::move(entry));
+        }
+
+        // Load outside the lock; waiters on this key block on the shared future
+        Value value;
+        try {
+            value = load();
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stats_.failures++;
+                entries_.erase(key);
+            }
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+
+        insertLoaded(key, value, admit);
+        promise.set_value(value);
+        return value;
+    }
+
+    // Only from an AdmitFunction: evicts the loaded entries whose key `matches`.
+    void evictLocked(const std::function<bool(const std::string& key)>& matches) {
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            auto current = it++;
+            if (current->second.ready && matches(current->first)) {
+                eraseEntry(current);
+                stats_.evictions++;
+            }
+        }
+    }
+
+    SingleFlightLruCacheStats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        SingleFlightLruCacheStats stats = stats_;
+        stats.entries = lru_.size();
+        stats.bytes_in_use = bytes_in_use_;
+        stats.byte_budget = byte_budget_;
+        return stats;
+    }
+
+    void setByteBudget(size_t byte_budget) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        byte_budget_ = byte_budget;
+        evictIfNeeded();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // In-flight loads keep their entries so that their waiters still get a result
+        while (!lru_.empty()) {
+            eraseEntry(entries_.find(lru_.back()));
+        }
+    }
+
+private:
+    struct Entry {
+        std::shared_future<Value> value;
+        size_t bytes = 0;
+        bool ready = false;
+        std::list<std::string>::iterator lru_position;
+    };
+
+    void insertLoaded(const std::string& key, const Value& value, const AdmitFunction& admit) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return;
+        }
+        if (admit && !admit(key)) {
+            entries_.erase(it);
+            return;
+        }
+
+        Entry& entry = it->second;
+        entry.ready = true;
+        entry.bytes = size_of_(key, value);
+        lru_.push_front(key);
+        entry.lru_position = lru_.begin();
+        bytes_in_use_ += entry.bytes;
+        evictIfNeeded();
+    }
+
+    void evictIfNeeded() {
+        while (bytes_in_use_ > byte_budget_ && !lru_.empty()) {
+            eraseEntry(entries_.find(lru_.back()));
+            stats_.evictions++;
+        }
+    }
+
+    void eraseEntry(typename std::unordered_map<std::string, Entry>::iterator it) {
+        Entry& entry = it->second;
+        if (entry.ready) {
+            lru_.erase(entry.lru_position);
+            bytes_in_use_ -= entry.bytes;
+        }
+        entries_.erase(it);
+    }
+
+    SizeFunction size_of_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> lru_; // Ready entries, most recent first
+    size_t byte_budget_;
+    size_t bytes_in_use_ = 0;
+    SingleFlightLruCacheStats stats_;
+};
+
+} // namespace fingraph
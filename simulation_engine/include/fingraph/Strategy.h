@@ -1,30 +1,102 @@
 #pragma once
+#include "fingraph/IndicatorCache.h"
 #include "fingraph/MarketData.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
 #include <vector>
 #include <string>
 #include <map>
+#include <limits>
 
 namespace fingraph {
 
-enum class Signal {
-    NONE,
-    BUY,
-    SELL
+// Values match the +1 / -1 / 0 direction codes of the indicator kernels, so code
+// arrays convert to signal arrays by a plain copy.
+enum class Signal : int8_t {
+    NONE = 0,
+    BUY = 1,
+    SELL = -1
 };
 
 class Strategy {
 public:
+    // getMaxLookback() value of strategies whose signals depend on the whole history.
+    static constexpr size_t kUnboundedLookback = std::numeric_limits<size_t>::max();
+
     Strategy(const std::string& name) : name_(name) {}
     virtual ~Strategy() = default;
     
-    virtual void initialize(const std::vector<OHLCV>& data) = 0;
+    virtual void initialize(const MarketDataView& data) = 0;
     virtual Signal generateSignal(size_t index) const = 0;
+    // Signals for bars [0, out.size()) in one call; what the backtest loop consumes.
+    // The default asks generateSignal() bar by bar, so strategies with precomputed
+    // signals should override it with a plain copy.
+    virtual void generateSignals(std::span<Signal> out) const {
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i] = generateSignal(i);
+        }
+    }
     virtual void updateParameters(const std::map<std::string, double>& params) = 0;
+
+    // Live mode, for feeds where bars arrive one at a time: pushes the next bar and
+    // returns its signal, the one the batch mode gives that bar for the same series
+    // (indicator values can differ in the last bits, so exact ties may not). Needs no
+    // initialize(); state is bounded by the lookback. The first bar after construction,
+    // resetStream() or updateParameters() starts a new stream. Strategies without a
+    // live mode throw std::logic_error.
+    virtual Signal onBar(const OHLCV& bar) {
+        (void)bar;
+        throw std::logic_error(name_ + " has no live (onBar) mode");
+    }
+    virtual void resetStream() {}
+
+    // The signal for bar i may depend on bars [i - lookback, i] only. Strategies
+    // with a finite lookback can be backtested over a stream in bounded memory.
+    virtual size_t getMaxLookback() const { return kUnboundedLookback; }
     
     const std::string& getName() const { return name_; }
+
+    // Lets initialize() share indicator columns with other strategies through `cache`.
+    // `datasetKey` must identify exactly the bars later passed to initialize(); a null
+    // cache or an empty key makes the strategy compute its indicators privately.
+    void setIndicatorCache(IndicatorCache* cache, std::string datasetKey) {
+        indicatorCache_ = cache;
+        datasetKey_ = std::move(datasetKey);
+    }
     
 protected:
     std::string name_;
+
+    // Fills `out` from +1 / -1 / 0 direction codes, with NONE before `firstBar` and
+    // past the end of `codes`.
+    static void copySignalCodes(std::span<const int8_t> codes, size_t firstBar, std::span<Signal> out) {
+        size_t begin = std::min(firstBar, out.size());
+        size_t end = std::max(begin, std::min(codes.size(), out.size()));
+        std::fill(out.begin(), out.begin() + begin, Signal::NONE);
+        for (size_t i = begin; i < end; ++i) {
+            out[i] = static_cast<Signal>(codes[i]);
+        }
+        std::fill(out.begin() + end, out.end(), Signal::NONE);
+    }
+
+    // The `size`-value column named `indicatorKey` (e.g. "SMA(close,50)"), taken from
+    // the indicator cache when one is set and otherwise computed with `compute`.
+    IndicatorCache::Column getIndicator(const std::string& indicatorKey, size_t size,
+                                        const std::function<void(std::span<double>)>& compute) const {
+        if (indicatorCache_ && !datasetKey_.empty()) {
+            return indicatorCache_->get(datasetKey_, indicatorKey, size, compute);
+        }
+        auto values = std::make_shared<AlignedVector<double>>(size);
+        compute(std::span<double>(values->data(), values->size()));
+        return values;
+    }
+
+private:
+    IndicatorCache* indicatorCache_ = nullptr;
+    std::string datasetKey_;
 };
 
 } // namespace fingraph
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fingraph {
+
+// Dense integer handle of an interned symbol: 0, 1, 2, ... in order of interning.
+using SymbolId = uint32_t;
+
+/**
+ * @class SymbolTable
+ * @brief Interns symbol names as dense SymbolIds, so per-symbol state can live in flat arrays.
+ *
+ * Interning the symbols of a MarketPanel in panel order makes each id equal to
+ * the symbol's panel index.
+ */
+class SymbolTable {
+public:
+    static constexpr SymbolId kNotFound = std::numeric_limits<SymbolId>::max();
+
+    // Returns the symbol's id, adding it if it is new.
+    SymbolId intern(const std::string& symbol);
+    // Returns the symbol's id, or kNotFound if it was never interned.
+    SymbolId find(const std::string& symbol) const;
+
+    const std::string& getName(SymbolId id) const { return names_[id]; }
+    size_t size() const { return names_.size(); }
+
+private:
+    std::unordered_map<std::string, SymbolId> ids_;
+    std::vector<std::string> names_;
+};
+
+} // namespace fingraph
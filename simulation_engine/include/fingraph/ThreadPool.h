@@ -0,0 +1,60 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace fingraph {
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads running submitted tasks in FIFO order.
+ *
+ * Meant for short CPU-bound tasks such as parsing one chunk of a file. Tasks must
+ * not block waiting for other tasks of the same pool. The destructor finishes the
+ * queued tasks before joining the workers.
+ */
+class ThreadPool {
+public:
+    // `threadCount` of 0 uses one thread per hardware core.
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers_.size(); }
+
+    // Queues `task`; the future carries its result or exception.
+    template <typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> result = packaged->get_future();
+        enqueue([packaged] { (*packaged)(); });
+        return result;
+    }
+
+    // Process-wide pool with one thread per hardware core, created on first use.
+    static ThreadPool& shared();
+
+    // Number of hardware cores, never less than 1.
+    static size_t hardwareThreads();
+
+private:
+    void enqueue(std::function<void()> task);
+    void workerLoop();
+
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
+
+} // namespace fingraph
@@ -1,10 +1,30 @@
 #pragma once
+#include "fingraph/SymbolTable.h"
 #include <string>
 #include <chrono>
+#include <cstdint>
+#include <type_traits>
 
 namespace fingraph {
 
-enum class TradeType { BUY, SELL };
+enum class TradeType : uint8_t { BUY, SELL };
+
+// "BUY" or "SELL", for serialization.
+const char* toString(TradeType type);
+
+// A fill as a Portfolio logs it: a trivially copyable record with the symbol
+// interned in that portfolio's SymbolTable. Names are looked up only where trades
+// leave the engine (JSON, gRPC), so logging a trade copies 32 bytes and no string.
+struct TradeRecord {
+    std::chrono::system_clock::time_point timestamp;
+    double quantity;
+    double price;
+    SymbolId symbol;
+    TradeType type;
+
+    double getValue() const { return quantity * price; }
+};
+static_assert(std::is_trivially_copyable_v<TradeRecord> && sizeof(TradeRecord) == 32);
 
 class Trade {
 public:
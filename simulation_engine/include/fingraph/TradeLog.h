@@ -0,0 +1,104 @@
+#pragma once
+#include "fingraph/Trade.h"
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace fingraph {
+
+/**
+ * @class TradeLog
+ * @brief Append-only log of TradeRecords in geometrically growing blocks.
+ *
+ * Block k holds kFirstBlockRecords << k records, so appending never moves a
+ * record already written (unlike a growing vector) and a log of n trades
+ * allocates O(log n) blocks. Moving a log moves its blocks; copying it copies
+ * the records.
+ */
+class TradeLog {
+public:
+    static constexpr size_t kFirstBlockRecords = 64;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TradeRecord;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const TradeRecord*;
+        using reference = const TradeRecord&;
+
+        const_iterator() = default;
+        const_iterator(const TradeLog* log, size_t index) : log_(log), index_(index) {}
+
+        reference operator*() const { return (*log_)[index_]; }
+        pointer operator->() const { return &(*log_)[index_]; }
+        const_iterator& operator++() {
+            ++index_;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++index_;
+            return previous;
+        }
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+
+    private:
+        const TradeLog* log_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    TradeLog() = default;
+    TradeLog(const TradeLog& other);
+    TradeLog& operator=(const TradeLog& other);
+    TradeLog(TradeLog&& other) noexcept;
+    TradeLog& operator=(TradeLog&& other) noexcept;
+
+    void push_back(const TradeRecord& record) {
+        if (size_ == capacity_) {
+            addBlock();
+        }
+        Position at = locate(size_);
+        blocks_[at.block][at.offset] = record;
+        ++size_;
+    }
+    // Allocates blocks for at least `records` records up front.
+    void reserve(size_t records);
+    // Drops the records but keeps the blocks for reuse.
+    void clear() { size_ = 0; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+
+    const TradeRecord& operator[](size_t index) const {
+        Position at = locate(index);
+        return blocks_[at.block][at.offset];
+    }
+    const TradeRecord& back() const { return (*this)[size_ - 1]; }
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size_}; }
+
+private:
+    struct Position {
+        size_t block;
+        size_t offset;
+    };
+
+    // Blocks before k hold kFirstBlockRecords * (2^k - 1) records in total.
+    static Position locate(size_t index) {
+        size_t block = std::bit_width(index / kFirstBlockRecords + 1) - 1;
+        return {block, index - kFirstBlockRecords * ((size_t(1) << block) - 1)};
+    }
+
+    void addBlock();
+
+    std::vector<std::unique_ptr<TradeRecord[]> > blocks_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+} // namespace fingraph
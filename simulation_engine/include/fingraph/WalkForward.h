@@ -0,0 +1,99 @@
+#pragma once
+
+#include "fingraph/Backtest.h"
+#include "fingraph/ParameterSweep.h"
+#include "fingraph/ThreadPool.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace fingraph {
+
+struct WalkForwardOptions {
+    // Bars each fold optimizes over, and the bars it then trades out of sample;
+    // fold k tests bars [in + k * out, in + (k + 1) * out), the last one up to the end.
+    size_t inSampleBars = 0;
+    size_t outOfSampleBars = 0;
+    // Anchored folds optimize over every bar before their test; rolling ones over
+    // the last inSampleBars only.
+    bool anchored = false;
+    // How each fold searches the grid, and by which metric it picks its parameters.
+    SweepMode mode = SweepMode::GRID;
+    SweepMetric metric = SweepMetric::SHARPE_RATIO;
+    SuccessiveHalvingOptions halving;
+    GeneticOptions genetic;
+    // Called from the thread running the analysis with the fraction of folds done.
+    std::function<void(double)> onProgress;
+    // Polled by the folds' searches; once set, the remaining work is skipped.
+    const std::atomic<bool>* cancelled = nullptr;
+};
+
+struct WalkForwardFold {
+    size_t inSampleBegin = 0; // Bars [begin, end) of the data
+    size_t inSampleEnd = 0;
+    size_t outOfSampleBegin = 0;
+    size_t outOfSampleEnd = 0;
+    // The in-sample best point and its parameters, which traded out of sample.
+    size_t gridIndex = 0;
+    std::map<std::string, double> parameters;
+    double inSampleValue = 0.0; // Its metric in sample
+    // Out-of-sample metrics, over the fold's own bars.
+    double totalReturn = 0.0;
+    double sharpeRatio = 0.0;
+    double maxDrawdown = 0.0;
+    size_t tradeCount = 0;
+    // Set when no point ran in sample or the test failed; the fold then stays in cash.
+    std::string error;
+};
+
+struct WalkForwardResult {
+    std::vector<WalkForwardFold> folds;
+    // The out-of-sample runs stitched into one: the equity curve chains the folds'
+    // returns, each fold trading the capital the previous one ended with, and the
+    // metrics, trades and costs cover every fold.
+    BacktestResult outOfSample;
+    size_t barsExecuted = 0; // By the in-sample searches and the tests, warm-up included
+    bool cancelled = false;
+};
+
+/**
+ * @class WalkForward
+ * @brief Walk-forward analysis: optimize in sample, trade out of sample, fold after fold.
+ *
+ * Every fold works on zero-copy slices of the one MarketDataView. The folds run
+ * concurrently, each searching its in-sample slice with a ParameterSweep on the
+ * shared pool; with a dataset key, the points of a fold share their indicators
+ * through the engine's indicator cache. A fold's test starts the strategy its
+ * lookback before the out-of-sample bars, so indicators are warm when trading
+ * starts without being computed over the full history; the warm-up bars are
+ * dropped from the stitched curve. Folds test from the same initial cash and
+ * their returns are chained afterwards, so no fold waits for the previous one.
+ */
+class WalkForward {
+public:
+    explicit WalkForward(BacktestEngine& engine, ThreadPool& pool = ThreadPool::shared());
+
+    // Throws std::invalid_argument when the windows are empty or leave no bars to test.
+    // Blocks on the pool, so must not be called from one of its tasks.
+    WalkForwardResult run(const MarketDataView& data,
+                          const std::string& strategyName,
+                          const ParameterGrid& grid,
+                          double initialCash,
+                          const WalkForwardOptions& options,
+                          const std::string& datasetKey = {});
+
+private:
+    // Optimizes and tests one fold; returns its out-of-sample equity curve, trades and
+    // costs from `initialCash`, without warm-up.
+    BacktestResult runFold(const MarketDataView& data, const std::string& strategyName,
+                           const ParameterGrid& grid, double initialCash, const WalkForwardOptions& options,
+                           const std::string& datasetKey, WalkForwardFold& fold, size_t& barsExecuted);
+
+    BacktestEngine& engine_;
+    ThreadPool& pool_;
+};
+
+} // namespace fingraph
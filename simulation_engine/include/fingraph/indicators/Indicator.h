@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+namespace fingraph {
+
+// Indicators in this directory share one shape: update() pushes a single bar in
+// O(1) and returns the current value, compute() resets and runs over whole
+// columns (leaving the indicator ready to continue with update()), and values
+// are kIndicatorWarmingUp until enough bars have been seen.
+
+// Value reported by an indicator until it has seen enough bars.
+inline constexpr double kIndicatorWarmingUp = std::numeric_limits<double>::quiet_NaN();
+
+// Throws std::invalid_argument if a batch output column cannot hold one value per input.
+inline void checkIndicatorOutput(size_t inputSize, size_t outputSize) {
+    if (outputSize < inputSize) {
+        throw std::invalid_argument("Indicator output is shorter than its input");
+    }
+}
+
+} // namespace fingraph
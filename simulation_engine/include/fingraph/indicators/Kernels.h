@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fingraph {
+
+// Simple-smoothing RSI of a window without losses: the relative strength is capped
+// at 100, as RSIStrategy has always computed it, so such a window reads 100 - 100 / 101.
+inline constexpr double kRsiWithoutLosses = 100.0 - 100.0 / 101.0;
+
+/**
+ * @struct IndicatorKernels
+ * @brief Batch kernels over contiguous columns, in one instruction-set flavour.
+ *
+ * Every flavour computes the same functions. The element-wise kernels give
+ * bit-identical results across flavours; rollingSum, sum and
+ * sumSquaredDeviations add in a different order, so they agree to rounding
+ * error only. getIndicatorKernels() returns the fastest flavour this CPU
+ * supports, chosen once via CPUID; the scalar flavour is the reference.
+ *
+ * Direction codes are +1 (up / buy), -1 (down / sell) and 0 (nothing).
+ */
+struct IndicatorKernels {
+    const char* name; // "scalar", "sse2", "avx2" or "avx512"
+
+    // out[i] = in[i - period + 1] + ... + in[i], times `scale`, for i >= period - 1;
+    // NaN before. Pass scale = 1.0 / period for a moving average. period must be > 0.
+    // Outputs after a NaN input are unspecified.
+    void (*rollingSum)(const double* in, size_t n, size_t period, double scale, double* out);
+    // gains[i] / losses[i] = the rise / fall from prices[i - 1] to prices[i]; index 0 is 0.
+    void (*priceChanges)(const double* prices, size_t n, double* gains, double* losses);
+    // out[i] = 100 * gain / (gain + loss), with negatives clamped to 0; kRsiWithoutLosses
+    // where the loss is 0.
+    void (*relativeStrength)(const double* gainSums, const double* lossSums, size_t n, double* out);
+    // out[i] = (values[i + 1] - values[i]) / values[i], for i < n - 1.
+    void (*returns)(const double* values, size_t n, double* out);
+    // out[i] = +1 where `a` crosses above `b` between i - 1 and i, -1 where it crosses
+    // below, else 0 (always 0 at i = 0 and wherever a value is NaN).
+    void (*crossovers)(const double* a, const double* b, size_t n, int8_t* out);
+    // out[i] = +1 where in[i] <= low, else -1 where in[i] >= high, else 0.
+    void (*thresholds)(const double* in, size_t n, double low, double high, int8_t* out);
+    double (*sum)(const double* in, size_t n);
+    // Sum of (in[i] - mean)^2.
+    double (*sumSquaredDeviations)(const double* in, size_t n, double mean);
+};
+
+// The fastest flavour supported by this CPU.
+const IndicatorKernels& getIndicatorKernels();
+// The portable reference flavour.
+const IndicatorKernels& getScalarIndicatorKernels();
+// Every flavour this CPU can run, scalar first (for tests and benchmarks).
+std::vector<const IndicatorKernels*> getSupportedIndicatorKernels();
+
+} // namespace fingraph
@@ -0,0 +1,126 @@
+#pragma once
+#include "fingraph/indicators/Indicator.h"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace fingraph {
+
+/**
+ * @class RollingSum
+ * @brief Sum of the last `period` values, updated in O(1) per value.
+ *
+ * The sum is carried with a compensation term (Neumaier summation), so adding
+ * the new value and removing the oldest one does not accumulate rounding error
+ * over long series.
+ */
+class RollingSum {
+public:
+    // Throws std::invalid_argument if period is 0.
+    explicit RollingSum(size_t period);
+
+    // Pushes one value and returns the sum of the last `period` values (fewer while filling).
+    double update(double value);
+    void reset();
+
+    size_t getPeriod() const { return window_.size(); }
+    size_t getCount() const { return count_; } // Values in the window, at most the period
+    bool isReady() const { return count_ == window_.size(); }
+    double getSum() const { return sum_ + compensation_; }
+    // The value the next update() drops from a full window.
+    double getOldest() const { return window_[next_]; }
+
+private:
+    void add(double value);
+
+    std::vector<double> window_; // Ring buffer of the last `period` values
+    size_t next_ = 0;
+    size_t count_ = 0;
+    double sum_ = 0.0;
+    double compensation_ = 0.0;
+};
+
+/**
+ * @class SimpleMovingAverage
+ * @brief Arithmetic mean of the last `period` values.
+ */
+class SimpleMovingAverage {
+public:
+    explicit SimpleMovingAverage(size_t period) : sum_(period) {}
+
+    // Pushes one value; returns the average, or kIndicatorWarmingUp before `period` values.
+    double update(double value);
+    // Resets, then pushes every input: output[i] is the value after input[i].
+    // Runs the vectorized rollingSum kernel, so values can differ from update()'s
+    // in the last bits. Throws std::invalid_argument if output is shorter than input.
+    void compute(std::span<const double> input, std::span<double> output);
+    void reset() { sum_.reset(); }
+
+    size_t getPeriod() const { return sum_.getPeriod(); }
+    bool isReady() const { return sum_.isReady(); }
+    double getValue() const { return isReady() ? sum_.getSum() / getPeriod() : kIndicatorWarmingUp; }
+
+private:
+    RollingSum sum_;
+};
+
+/**
+ * @class ExponentialMovingAverage
+ * @brief Exponentially weighted average, seeded with the mean of the first `period` values.
+ *
+ * The default smoothing factor is 2 / (period + 1); wilder() builds the 1 / period
+ * variant used by RSI and ATR.
+ */
+class ExponentialMovingAverage {
+public:
+    // Throws std::invalid_argument if period is 0.
+    explicit ExponentialMovingAverage(size_t period);
+    static ExponentialMovingAverage wilder(size_t period);
+
+    double update(double value);
+    void compute(std::span<const double> input, std::span<double> output);
+    void reset();
+
+    size_t getPeriod() const { return period_; }
+    double getAlpha() const { return alpha_; }
+    bool isReady() const { return count_ >= period_; }
+    double getValue() const { return isReady() ? value_ : kIndicatorWarmingUp; }
+
+private:
+    ExponentialMovingAverage(size_t period, double alpha);
+
+    size_t period_;
+    double alpha_;
+    size_t count_ = 0;
+    double value_ = 0.0; // Running sum while seeding, then the average
+};
+
+/**
+ * @class Macd
+ * @brief Moving average convergence/divergence: fast EMA minus slow EMA, with a
+ * signal line (an EMA of that difference) and their difference, the histogram.
+ */
+class Macd {
+public:
+    explicit Macd(size_t fastPeriod = 12, size_t slowPeriod = 26, size_t signalPeriod = 9);
+
+    // Pushes one value and returns the MACD line (kIndicatorWarmingUp until the slow EMA is ready).
+    double update(double value);
+    void compute(std::span<const double> input, std::span<double> macd, std::span<double> signal,
+                 std::span<double> histogram);
+    void reset();
+
+    // All three are ready once the signal line is.
+    bool isReady() const { return signal_.isReady(); }
+    double getValue() const { return slow_.isReady() ? line_ : kIndicatorWarmingUp; }
+    double getSignal() const { return signal_.getValue(); }
+    double getHistogram() const { return isReady() ? line_ - signal_.getValue() : kIndicatorWarmingUp; }
+
+private:
+    ExponentialMovingAverage fast_;
+    ExponentialMovingAverage slow_;
+    ExponentialMovingAverage signal_;
+    double line_ = 0.0;
+};
+
+} // namespace fingraph
@@ -0,0 +1,84 @@
+#pragma once
+#include "fingraph/indicators/Indicator.h"
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace fingraph {
+
+/**
+ * @class RollingExtremum
+ * @brief Minimum or maximum of the last `period` values, in amortized O(1) per value.
+ *
+ * Keeps a monotonic queue of the values that can still become the extremum: a
+ * new value evicts every queued value it beats, so the front is always the
+ * answer and each value is queued and dropped once. The queue lives in a ring
+ * of `period` slots, so updates never allocate.
+ */
+template <typename Better>
+class RollingExtremum {
+public:
+    // Throws std::invalid_argument if period is 0.
+    explicit RollingExtremum(size_t period) : period_(period) {
+        if (period == 0) {
+            throw std::invalid_argument("Indicator period must be positive");
+        }
+        ring_.resize(period);
+    }
+
+    // Pushes one value; returns the extremum, or kIndicatorWarmingUp before `period` values.
+    double update(double value) {
+        // Drop the front once it has left the window
+        if (size_ > 0 && ring_[head_].position + period_ <= position_) {
+            head_ = wrap(head_ + 1);
+            size_--;
+        }
+        // A value no better than the new one can never be the extremum again
+        while (size_ > 0 && !Better{}(ring_[wrap(head_ + size_ - 1)].value, value)) {
+            size_--;
+        }
+        ring_[wrap(head_ + size_)] = {value, position_};
+        size_++;
+        position_++;
+        return getValue();
+    }
+
+    void compute(std::span<const double> input, std::span<double> output) {
+        checkIndicatorOutput(input.size(), output.size());
+        reset();
+        for (size_t i = 0; i < input.size(); ++i) {
+            output[i] = update(input[i]);
+        }
+    }
+
+    void reset() {
+        head_ = 0;
+        size_ = 0;
+        position_ = 0;
+    }
+
+    size_t getPeriod() const { return period_; }
+    bool isReady() const { return position_ >= period_; }
+    double getValue() const { return isReady() ? ring_[head_].value : kIndicatorWarmingUp; }
+
+private:
+    struct Candidate {
+        double value;
+        size_t position;
+    };
+
+    size_t wrap(size_t slot) const { return slot >= period_ ? slot - period_ : slot; }
+
+    size_t period_;
+    std::vector<Candidate> ring_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+    size_t position_ = 0; // Values pushed so far
+};
+
+using RollingMin = RollingExtremum<std::less<double>>;
+using RollingMax = RollingExtremum<std::greater<double>>;
+
+} // namespace fingraph
@@ -0,0 +1,52 @@
+#pragma once
+#include "fingraph/indicators/MovingAverages.h"
+#include <span>
+
+namespace fingraph {
+
+/**
+ * @class RelativeStrengthIndex
+ * @brief RSI = 100 * average gain / (average gain + average loss) over `period` price changes.
+ *
+ * With Smoothing::Wilder the averages are Wilder's exponential ones, seeded with
+ * the mean of the first `period` changes, so every past bar keeps some weight.
+ * With Smoothing::Simple they are plain means of the last `period` changes (a
+ * finite window). Either way the first value comes after `period + 1` prices.
+ * With Wilder smoothing a window without losses reads 100, or 50 without gains
+ * either. Simple smoothing keeps RSIStrategy's original mapping, which caps the
+ * relative strength at 100: any window without losses reads kRsiWithoutLosses
+ * (about 99.01), flat ones included.
+ */
+class RelativeStrengthIndex {
+public:
+    enum class Smoothing { Wilder, Simple };
+
+    // Throws std::invalid_argument if period is 0.
+    explicit RelativeStrengthIndex(size_t period = 14, Smoothing smoothing = Smoothing::Wilder);
+
+    // Pushes one price; returns the RSI, or kIndicatorWarmingUp before `period + 1` prices.
+    double update(double price);
+    // With simple smoothing this runs the vector kernels, so values can differ
+    // from update()'s in the last bits.
+    void compute(std::span<const double> prices, std::span<double> output);
+    void reset();
+
+    size_t getPeriod() const { return period_; }
+    Smoothing getSmoothing() const { return smoothing_; }
+    bool isReady() const { return changes_ >= period_; }
+    double getValue() const;
+
+private:
+    size_t period_;
+    Smoothing smoothing_;
+    bool hasPrevious_ = false;
+    double previous_ = 0.0;
+    size_t changes_ = 0;
+    // Only one pair is in use, depending on the smoothing
+    ExponentialMovingAverage wilderGain_;
+    ExponentialMovingAverage wilderLoss_;
+    RollingSum gainSum_;
+    RollingSum lossSum_;
+};
+
+} // namespace fingraph
@@ -0,0 +1,86 @@
+#pragma once
+#include "fingraph/indicators/MovingAverages.h"
+#include <span>
+
+namespace fingraph {
+
+/**
+ * @class RollingStdDev
+ * @brief Population standard deviation of the last `period` values.
+ *
+ * Keeps a compensated rolling sum for the mean and updates the sum of squared
+ * deviations Welford-style as values enter and leave the window, instead of
+ * differencing a running sum of squares (which cancels catastrophically).
+ */
+class RollingStdDev {
+public:
+    // Throws std::invalid_argument if period is 0.
+    explicit RollingStdDev(size_t period);
+
+    // Pushes one value; returns the deviation, or kIndicatorWarmingUp before `period` values.
+    double update(double value);
+    void compute(std::span<const double> input, std::span<double> output);
+    void reset();
+
+    size_t getPeriod() const { return sum_.getPeriod(); }
+    bool isReady() const { return sum_.isReady(); }
+    double getMean() const { return isReady() ? mean_ : kIndicatorWarmingUp; }
+    double getValue() const;
+
+private:
+    RollingSum sum_;
+    double mean_ = 0.0;
+    double squaredDeviations_ = 0.0;
+};
+
+/**
+ * @class BollingerBands
+ * @brief Moving average of the last `period` values, with bands `width` standard deviations above and below.
+ */
+class BollingerBands {
+public:
+    explicit BollingerBands(size_t period = 20, double width = 2.0) : stdDev_(period), width_(width) {}
+
+    // Pushes one value and returns the middle band.
+    double update(double value);
+    void compute(std::span<const double> input, std::span<double> middle, std::span<double> upper,
+                 std::span<double> lower);
+    void reset() { stdDev_.reset(); }
+
+    bool isReady() const { return stdDev_.isReady(); }
+    double getMiddle() const { return stdDev_.getMean(); }
+    double getUpper() const { return stdDev_.getMean() + width_ * stdDev_.getValue(); }
+    double getLower() const { return stdDev_.getMean() - width_ * stdDev_.getValue(); }
+
+private:
+    RollingStdDev stdDev_;
+    double width_;
+};
+
+/**
+ * @class AverageTrueRange
+ * @brief Wilder average of the true range: the bar's range extended to the previous close.
+ *
+ * The first bar's true range is its high - low; the first value comes after `period` bars.
+ */
+class AverageTrueRange {
+public:
+    // Throws std::invalid_argument if period is 0.
+    explicit AverageTrueRange(size_t period = 14) : average_(ExponentialMovingAverage::wilder(period)) {}
+
+    double update(double high, double low, double close);
+    void compute(std::span<const double> highs, std::span<const double> lows, std::span<const double> closes,
+                 std::span<double> output);
+    void reset();
+
+    size_t getPeriod() const { return average_.getPeriod(); }
+    bool isReady() const { return average_.isReady(); }
+    double getValue() const { return average_.getValue(); }
+
+private:
+    ExponentialMovingAverage average_;
+    bool hasPrevious_ = false;
+    double previousClose_ = 0.0;
+};
+
+} // namespace fingraph
@@ -1,4 +1,7 @@
 #include "fingraph/Strategy.h"
+#include "fingraph/indicators/MovingAverages.h"
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 namespace fingraph {
@@ -12,7 +15,7 @@ namespace fingraph {
  * indicating potential upward momentum. It generates a SELL signal when the short
  * SMA crosses below the long SMA, indicating potential downward momentum.
  */
-class MovingAverageStrategy : public Strategy {
+class MovingAverageStrategy final : public Strategy {
 public:
     /**
      * @brief Constructor for MovingAverageStrategy.
@@ -30,18 +33,37 @@ public:
      *
      * This method pre-calculates the short and long moving averages for the entire
      * dataset to ensure that the generateSignal method is fast during the backtest.
+     * The averages come from the indicator cache when one is set, so strategies with
+     * a period in common share that average.
      *
-     * @param data A vector of OHLCV data points.
+     * @param data Column view of the OHLCV data points.
      */
-    void initialize(const std::vector<OHLCV>& data) override;
+    void initialize(const MarketDataView& data) override;
 
     /**
      * @brief Generates a trading signal for a specific point in time.
      *
      * @param index The index in the original data vector for which to generate a signal.
+     * Defined inline: the class is final, so the backtest loop specialized for it
+     * (see CompiledStrategy) can inline this call.
+     *
      * @return A Signal enum value (BUY, SELL, or NONE).
      */
-    Signal generateSignal(size_t index) const override;
+    Signal generateSignal(size_t index) const override {
+        // Cannot generate a signal before the long MA is fully calculated
+        if (index < longPeriod_ || index >= crossovers_.size()) {
+            return Signal::NONE;
+        }
+        // +1: the short MA crossed above the long MA (bullish), -1: crossed below (bearish)
+        return static_cast<Signal>(crossovers_[index]);
+    }
+
+    /**
+     * @brief Generates the signals for a run of bars at once.
+     *
+     * @param out Receives the signal for bars 0 to out.size() - 1, as generateSignal() would.
+     */
+    void generateSignals(std::span<Signal> out) const override;
 
     /**
      * @brief Updates the strategy's parameters.
@@ -51,17 +73,49 @@ public:
      */
     void updateParameters(const std::map<std::string, double>& params) override;
 
+    /**
+     * @brief Live mode: updates both averages with the bar's close and reports a crossover.
+     *
+     * O(1) per bar; the state is the two averages' windows.
+     *
+     * @param bar The next bar of the feed.
+     * @return The signal for this bar, as generateSignal() gives it in batch mode.
+     */
+    Signal onBar(const OHLCV& bar) override;
+
+    /**
+     * @brief Makes the next onBar() start a new stream.
+     */
+    void resetStream() override;
+
+    /**
+     * @brief A crossover at bar i compares both averages at i and i - 1.
+     * @return The longer of the two periods.
+     */
+    size_t getMaxLookback() const override;
+
 private:
     size_t shortPeriod_;         ///< The period for the short-term moving average.
     size_t longPeriod_;          ///< The period for the long-term moving average.
-    std::vector<double> shortMA_; ///< Pre-calculated values of the short moving average.
-    std::vector<double> longMA_;  ///< Pre-calculated values of the long moving average.
+    IndicatorCache::Column shortMA_; ///< Pre-calculated values of the short moving average (NaN while warming up).
+    IndicatorCache::Column longMA_;  ///< Pre-calculated values of the long moving average (NaN while warming up).
+    std::vector<int8_t> crossovers_; ///< +1 / -1 where the short MA crosses above / below the long MA.
+
+    /// onBar() state, built on the first bar of a stream.
+    struct StreamState {
+        SimpleMovingAverage shortMA;
+        SimpleMovingAverage longMA;
+        double previousShort = kIndicatorWarmingUp;
+        double previousLong = kIndicatorWarmingUp;
+        size_t bars = 0; ///< Bars seen before the current one
+    };
+    std::optional<StreamState> stream_;
 
     /**
-     * @brief Calculates the simple moving averages for the entire dataset.
-     * @param data The OHLCV data to use for the calculation.
+     * @brief Calculates the simple moving averages, and where they cross, for the entire dataset.
+     * @param closes The closing-price column to use for the calculation.
      */
-    void calculateMovingAverages(const std::vector<OHLCV>& data);
+    void calculateMovingAverages(std::span<const double> closes);
 };
 
 } // namespace fingraph
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include "fingraph/Strategy.h"
+#include "fingraph/indicators/Rsi.h"
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 namespace fingraph {
@@ -12,7 +15,7 @@ namespace fingraph {
  * when the RSI crosses up through the oversold threshold (e.g., 30) and a SELL signal
  * when it crosses down through the overbought threshold (e.g., 70).
  */
-class RSIStrategy : public Strategy {
+class RSIStrategy final : public Strategy {
 public:
     /**
      * @brief Constructor for RSIStrategy.
@@ -29,19 +32,35 @@ public:
      * @brief Initializes the strategy with historical market data.
      *
      * This method pre-calculates the RSI values for the entire dataset to optimize
-     * the performance of the backtest simulation loop.
+     * the performance of the backtest simulation loop. They come from the indicator
+     * cache when one is set, so runs that differ only in thresholds share them.
      *
-     * @param data A vector of OHLCV data points.
+     * @param data Column view of the OHLCV data points.
      */
-    void initialize(const std::vector<OHLCV>& data) override;
+    void initialize(const MarketDataView& data) override;
 
     /**
      * @brief Generates a trading signal for a specific point in time.
      *
      * @param index The index in the original data vector for which to generate a signal.
+     * Defined inline so that the backtest loop specialized for this class can inline it.
+     *
      * @return A Signal enum value (BUY, SELL, or NONE).
      */
-    Signal generateSignal(size_t index) const override;
+    Signal generateSignal(size_t index) const override {
+        if (index < period_ || index >= signals_.size()) {
+            return Signal::NONE;
+        }
+        // +1: at or below the oversold threshold, -1: at or above the overbought one
+        return static_cast<Signal>(signals_[index]);
+    }
+
+    /**
+     * @brief Generates the signals for a run of bars at once.
+     *
+     * @param out Receives the signal for bars 0 to out.size() - 1, as generateSignal() would.
+     */
+    void generateSignals(std::span<Signal> out) const override;
 
     /**
      * @brief Updates the strategy's parameters.
@@ -51,21 +70,50 @@ public:
      */
     void updateParameters(const std::map<std::string, double>& params) override;
 
+    /**
+     * @brief Live mode: updates the RSI with the bar's close and checks the thresholds.
+     *
+     * O(1) per bar; the state is the RSI's window of price changes.
+     *
+     * @param bar The next bar of the feed.
+     * @return The signal for this bar, as generateSignal() gives it in batch mode.
+     */
+    Signal onBar(const OHLCV& bar) override;
+
+    /**
+     * @brief Makes the next onBar() start a new stream.
+     */
+    void resetStream() override;
+
+    /**
+     * @brief The RSI at bar i averages the price changes of the last `period` bars.
+     * @return The RSI period.
+     */
+    size_t getMaxLookback() const override;
+
 private:
     size_t period_;                 ///< The lookback period for RSI calculation (typically 14).
     double oversoldThreshold_;      ///< The RSI level considered oversold (e.g., 30.0).
     double overboughtThreshold_;    ///< The RSI level considered overbought (e.g., 70.0).
-    std::vector<double> rsiValues_; ///< Pre-calculated RSI values for each data point.
+    IndicatorCache::Column rsiValues_; ///< Pre-calculated RSI values for each data point.
+    std::vector<int8_t> signals_;   ///< +1 / -1 where the RSI is oversold / overbought.
+
+    /// onBar() state, built on the first bar of a stream.
+    struct StreamState {
+        RelativeStrengthIndex rsi;
+        size_t bars = 0; ///< Bars seen before the current one
+    };
+    std::optional<StreamState> stream_;
 
     /**
      * @brief Calculates the RSI values for the entire dataset.
      *
-     * The calculation involves first determining average gains and losses over the period,
-     * then smoothing them, and finally computing the RSI.
+     * Average gains and losses are plain means over the last `period` price changes
+     * (see RelativeStrengthIndex::Smoothing::Simple).
      *
-     * @param data The OHLCV data to use for the calculation.
+     * @param closes The closing-price column to use for the calculation.
      */
-    void calculateRSI(const std::vector<OHLCV>& data);
+    void calculateRSI(std::span<const double> closes);
 };
 
 } // namespace fingraph
\ No newline at end of file
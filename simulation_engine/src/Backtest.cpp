@@ -1,29 +1,53 @@
 #include "fingraph/Backtest.h"
 #include "fingraph/MarketData.h"
+#include "fingraph/MarketDataStream.h"
 #include "fingraph/Portfolio.h"
 #include "fingraph/PerformanceMetrics.h"
 #include "fingraph/strategies/MovingAverageStrategy.h"
 #include "fingraph/strategies/RSIStrategy.h"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <stdexcept>
 #include <map>
 
 namespace fingraph {
 
+ExitRules ExitRules::fromParameters(const std::map<std::string, double>& params) {
+    ExitRules rules;
+    auto read = [&params](const char* name, double& value) {
+        auto it = params.find(name);
+        if (it == params.end()) {
+            return;
+        }
+        if (!(it->second >= 0)) {
+            throw std::invalid_argument(std::string(name) + " must be a non-negative fraction");
+        }
+        value = it->second;
+    };
+    read("stopLoss", rules.stopLoss);
+    read("takeProfit", rules.takeProfit);
+    read("trailingStop", rules.trailingStop);
+    if (rules.stopLoss >= 1) {
+        throw std::invalid_argument("stopLoss must be below 1");
+    }
+    return rules;
+}
+
 BacktestEngine::BacktestEngine() {
     initializeStrategies();
 }
 
 void BacktestEngine::initializeStrategies() {
     // Register all available strategies here
-    strategies_["Moving Average Crossover"] = std::make_unique<MovingAverageStrategy>();
-    strategies_["RSI Mean Reversion"] = std::make_unique<RSIStrategy>();
+    registerStrategy(std::make_unique<MovingAverageStrategy>());
+    registerStrategy(std::make_unique<RSIStrategy>());
 }
 
-Strategy* BacktestEngine::getStrategy(const std::string& name) {
+BacktestEngine::RegisteredStrategy& BacktestEngine::getStrategy(const std::string& name) {
     auto it = strategies_.find(name);
     if (it != strategies_.end()) {
-        return it->second.get();
+        return it->second;
     }
     throw std::invalid_argument("Strategy not found: " + name);
 }
@@ -36,55 +60,90 @@ std::vector<std::string> BacktestEngine::getAvailableStrategies() const {
     return names;
 }
 
+class BacktestEngine::StrategyLease {
+public:
+    StrategyLease(BacktestEngine& engine, const std::string& name)
+        : engine_(engine), registered_(engine.getStrategy(name)) {
+        {
+            std::lock_guard<std::mutex> lock(engine_.poolMutex_);
+            if (!registered_.idle.empty()) {
+                instance_ = std::move(registered_.idle.back()); // Already reset on release
+                registered_.idle.pop_back();
+            }
+        }
+        if (!instance_) {
+            registered_.reset(*registered_.prototype, instance_);
+        }
+    }
+
+    ~StrategyLease() {
+        try {
+            // Drops this run's parameters and indicator columns but keeps its buffers
+            registered_.reset(*registered_.prototype, instance_);
+        } catch (...) {
+            return; // Not worth keeping
+        }
+        std::lock_guard<std::mutex> lock(engine_.poolMutex_);
+        if (registered_.idle.size() < kMaxIdleInstances) {
+            registered_.idle.push_back(std::move(instance_));
+        }
+    }
+
+    StrategyLease(const StrategyLease&) = delete;
+    StrategyLease& operator=(const StrategyLease&) = delete;
+
+    Strategy& get() { return *instance_; }
+    SimulateFunction getSimulate(bool withCosts) const {
+        return withCosts ? registered_.simulateWithCosts : registered_.simulate;
+    }
+
+private:
+    BacktestEngine& engine_;
+    RegisteredStrategy& registered_;
+    std::unique_ptr<Strategy> instance_;
+};
+
 BacktestResult BacktestEngine::runBacktest(
     const std::string& dataPath,
     const std::string& strategyName,
     const std::map<std::string, double>& strategyParams,
     double initialCash) {
 
-    // 1. Setup
     MarketData marketData;
     if (!marketData.loadFromCSV(dataPath)) {
         throw std::runtime_error("Failed to load market data from " + dataPath);
     }
+    return runBacktest(marketData.getView(), strategyName, strategyParams, initialCash);
+}
+
+BacktestResult BacktestEngine::runBacktest(
+    const MarketDataView& data,
+    const std::string& strategyName,
+    const std::map<std::string, double>& strategyParams,
+    double initialCash,
+    const std::string& datasetKey) {
 
-    Strategy* strategy = getStrategy(strategyName);
+    // 1. Setup, on this run's own strategy instance
+    StrategyLease lease(*this, strategyName);
+    Strategy* strategy = &lease.get();
     strategy->updateParameters(strategyParams);
-    
-    const auto& data = marketData.getData();
+    strategy->setIndicatorCache(indicatorCache_, datasetKey);
     strategy->initialize(data); // Pre-calculate indicators
 
     Portfolio portfolio(initialCash);
+    Execution execution(portfolio, ExitRules::fromParameters(strategyParams),
+                        transactionCostsFromParameters(strategyParams));
     BacktestResult result;
+    result.equityCurve.reserve(data.size());
     
-    // 2. Simulation Loop
-    for (size_t i = 0; i < data.size(); ++i) {
-        const auto& candle = data[i];
-        
-        // Generate signal
-        Signal signal = strategy->generateSignal(i);
-
-        // Execute trade based on signal
-        if (signal == Signal::BUY && portfolio.getPosition("DEFAULT") == 0) { // Simple logic: one open position
-            double quantity = std::floor(portfolio.getCash() / candle.close); // All-in
-            if (quantity > 0) {
-                Trade trade("DEFAULT", TradeType::BUY, quantity, candle.close, candle.timestamp);
-                portfolio.addTrade(trade);
-            }
-        } else if (signal == Signal::SELL && portfolio.getPosition("DEFAULT") > 0) {
-            double quantity = portfolio.getPosition("DEFAULT");
-            Trade trade("DEFAULT", TradeType::SELL, quantity, candle.close, candle.timestamp);
-            portfolio.addTrade(trade);
-        }
-        
-        // 3. Record Equity Curve
-        std::map<std::string, double> currentPrices = { {"DEFAULT", candle.close} };
-        double totalValue = portfolio.getTotalValue(currentPrices);
-        result.equityCurve.emplace_back(candle.timestamp, totalValue);
-    }
+    // 2. Simulation Loop, 3. Record Equity Curve (specialized for the strategy type and,
+    // when costs are off, compiled without them)
+    lease.getSimulate(!execution.costModel.isFree())(*strategy, data, execution, result);
 
     // 4. Finalize Results
-    result.trades = portfolio.getTrades();
+    result.symbols = portfolio.getSymbols();
+    result.trades = portfolio.takeTrades();
+    result.totalCosts = execution.costsPaid;
     result.totalReturn = PerformanceMetrics::calculateTotalReturn(result.equityCurve);
     result.maxDrawdown = PerformanceMetrics::calculateMaxDrawdown(result.equityCurve);
     result.sharpeRatio = PerformanceMetrics::calculateSharpeRatio(result.equityCurve);
@@ -93,4 +152,96 @@ BacktestResult BacktestEngine::runBacktest(
     return result;
 }
 
+size_t BacktestEngine::getMaxLookback(const std::string& strategyName,
+                                      const std::map<std::string, double>& strategyParams) {
+    StrategyLease lease(*this, strategyName);
+    lease.get().updateParameters(strategyParams);
+    return lease.get().getMaxLookback();
+}
+
+BacktestResult BacktestEngine::runBacktest(
+    MarketDataStream& stream,
+    const std::string& strategyName,
+    const std::map<std::string, double>& strategyParams,
+    double initialCash) {
+
+    StrategyLease lease(*this, strategyName);
+    Strategy* strategy = &lease.get();
+    strategy->updateParameters(strategyParams); // Indicators are not cached: every window holds different bars
+    size_t lookback = strategy->getMaxLookback();
+    if (lookback == Strategy::kUnboundedLookback) {
+        throw std::invalid_argument("Strategy needs the full history and cannot run on a stream: " + strategyName);
+    }
+
+    Portfolio portfolio(initialCash);
+    // Orders rest across windows
+    Execution execution(portfolio, ExitRules::fromParameters(strategyParams),
+                        transactionCostsFromParameters(strategyParams));
+    bool withCosts = !execution.costModel.isFree();
+    EquityCurveAccumulator equity;
+    BacktestResult result;
+
+    // The window holds the last `lookback` bars already simulated, followed by the
+    // bars of the newest block; the strategy is re-initialized on each window.
+    ColumnBuffers window;
+    std::vector<Signal> signals;
+    size_t carried = 0;
+    while (true) {
+        bool more = stream.read(window) > 0;
+        while (more && window.size() <= lookback) {
+            more = stream.read(window) > 0; // Give the strategy a full lookback to start from
+        }
+        if (window.size() == carried) {
+            break;
+        }
+
+        MarketDataView view(window);
+        strategy->initialize(view);
+        signals.resize(view.size());
+        strategy->generateSignals(signals);
+        auto signalAt = [&](size_t i) { return signals[i]; };
+        auto record = [&](int64_t, double totalValue) { equity.add(totalValue); };
+        if (withCosts) {
+            simulate(signalAt, view, carried, execution, execution.costModel, record);
+        } else {
+            simulate(signalAt, view, carried, execution, NoCosts{}, record);
+        }
+
+        carried = std::min(lookback, window.size());
+        window.eraseFront(window.size() - carried);
+    }
+
+    result.symbols = portfolio.getSymbols();
+    result.trades = portfolio.takeTrades();
+    result.totalCosts = execution.costsPaid;
+    result.totalReturn = equity.getTotalReturn();
+    result.maxDrawdown = equity.getMaxDrawdown();
+    result.sharpeRatio = equity.getSharpeRatio();
+    result.winRate = PerformanceMetrics::calculateWinRate(result.trades);
+
+    return result;
+}
+
+void BacktestEngine::Execution::placeExits(SymbolId symbol, double quantity, double entryPrice) {
+    if (exits.stopLoss > 0) {
+        exitOrders.push_back(orders.place(
+            Order{symbol, TradeType::SELL, OrderType::STOP, quantity, entryPrice * (1 - exits.stopLoss)}));
+    }
+    if (exits.takeProfit > 0) {
+        exitOrders.push_back(orders.place(
+            Order{symbol, TradeType::SELL, OrderType::LIMIT, quantity, entryPrice * (1 + exits.takeProfit)}));
+    }
+    if (exits.trailingStop > 0) {
+        exitOrders.push_back(orders.place(Order{symbol, TradeType::SELL, OrderType::TRAILING_STOP, quantity,
+                                                entryPrice, entryPrice * exits.trailingStop}));
+    }
+}
+
+void BacktestEngine::Execution::cancelExits() {
+    for (OrderId id : exitOrders) {
+        orders.cancel(id); // False for the exit that filled
+    }
+    exitOrders.clear();
+}
+
 } // namespace fingraph
\ No newline at end of file
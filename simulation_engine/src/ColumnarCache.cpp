@@ -0,0 +1,259 @@
+#include "fingraph/ColumnarCache.h"
+#include "fingraph/GorillaCodec.h"
+#include "fingraph/MappedFile.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+
+namespace fingraph {
+
+static_assert(sizeof(ColumnarCacheHeader) == 256, "The .fgc header layout is part of the file format");
+static_assert(std::is_trivially_copyable_v<ColumnarCacheHeader>);
+
+namespace {
+
+constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint64_t headerChecksum(const ColumnarCacheHeader& header) {
+    return fnv1a64(&header, offsetof(ColumnarCacheHeader, headerChecksum));
+}
+
+constexpr uint64_t kElementSize[ColumnarCacheHeader::kColumnCount] = {
+    sizeof(int64_t), sizeof(double), sizeof(double), sizeof(double), sizeof(double), sizeof(uint64_t)};
+
+uint64_t blockCount(const ColumnarCacheHeader& header) {
+    return (header.rowCount + header.blockRows - 1) / header.blockRows;
+}
+
+// Block directory followed by the encoded blocks of one column.
+std::vector<uint8_t> encodeColumn(uint32_t column, const MarketDataView& data, size_t blockRows) {
+    size_t blocks = (data.size() + blockRows - 1) / blockRows;
+    std::vector<uint64_t> directory(blocks + 1);
+    std::vector<uint8_t> out(directory.size() * sizeof(uint64_t));
+    for (size_t b = 0; b < blocks; ++b) {
+        directory[b] = out.size();
+        size_t begin = b * blockRows;
+        size_t rows = std::min(blockRows, data.size() - begin);
+        switch (column) {
+        case 0: GorillaCodec::encodeTimestamps(data.getTimestamps().subspan(begin, rows), out); break;
+        case 1: GorillaCodec::encodeDoubles(data.getOpens().subspan(begin, rows), out); break;
+        case 2: GorillaCodec::encodeDoubles(data.getHighs().subspan(begin, rows), out); break;
+        case 3: GorillaCodec::encodeDoubles(data.getLows().subspan(begin, rows), out); break;
+        case 4: GorillaCodec::encodeDoubles(data.getCloses().subspan(begin, rows), out); break;
+        default: GorillaCodec::encodeVarints(data.getVolumes().subspan(begin, rows), out); break;
+        }
+    }
+    directory[blocks] = out.size();
+    std::memcpy(out.data(), directory.data(), directory.size() * sizeof(uint64_t));
+    return out;
+}
+
+// Decodes every block of a Gorilla cache into heap columns.
+bool decodeColumns(const char* base, const ColumnarCacheHeader& header, ColumnBuffers& out) {
+    size_t rows = static_cast<size_t>(header.rowCount);
+    out.timestamps.resize(rows);
+    out.open.resize(rows);
+    out.high.resize(rows);
+    out.low.resize(rows);
+    out.close.resize(rows);
+    out.volume.resize(rows);
+
+    uint64_t blocks = blockCount(header);
+    for (uint32_t c = 0; c < ColumnarCacheHeader::kColumnCount; ++c) {
+        const uint8_t* column = reinterpret_cast<const uint8_t*>(base + header.columnOffsets[c]);
+        const uint64_t* directory = reinterpret_cast<const uint64_t*>(column);
+        for (uint64_t b = 0; b < blocks; ++b) {
+            uint64_t begin = directory[b];
+            uint64_t end = directory[b + 1];
+            if (begin > end || end > header.columnBytes[c]) {
+                return false;
+            }
+            size_t at = static_cast<size_t>(b * header.blockRows);
+            size_t count = std::min<size_t>(header.blockRows, rows - at);
+            if (!ColumnarCache::decodeBlock(c, column + begin, static_cast<size_t>(end - begin), count, out, at)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+std::string ColumnarCache::cachePathFor(const std::string& sourcePath) {
+    return sourcePath + ".fgc";
+}
+
+bool ColumnarCache::write(const std::string& cachePath, const MarketDataView& data,
+                          const FileFingerprint& source, const LoadReport& report,
+                          CacheEncoding encoding) {
+    const void* columns[ColumnarCacheHeader::kColumnCount] = {
+        data.getTimestamps().data(), data.getOpens().data(), data.getHighs().data(),
+        data.getLows().data(), data.getCloses().data(), data.getVolumes().data()};
+    uint64_t columnBytes[ColumnarCacheHeader::kColumnCount];
+    for (uint32_t c = 0; c < ColumnarCacheHeader::kColumnCount; ++c) {
+        columnBytes[c] = kElementSize[c] * data.size();
+    }
+
+    std::vector<uint8_t> encoded[ColumnarCacheHeader::kColumnCount];
+    if (encoding == CacheEncoding::Gorilla) {
+        for (uint32_t c = 0; c < ColumnarCacheHeader::kColumnCount; ++c) {
+            encoded[c] = encodeColumn(c, data, ColumnarCacheHeader::kDefaultBlockRows);
+            columns[c] = encoded[c].data();
+            columnBytes[c] = encoded[c].size();
+        }
+    }
+
+    ColumnarCacheHeader header{};
+    header.magic = ColumnarCacheHeader::kMagic;
+    header.version = ColumnarCacheHeader::kVersion;
+    header.byteOrderMark = ColumnarCacheHeader::kByteOrderMark;
+    header.headerSize = sizeof(ColumnarCacheHeader);
+    header.columnCount = ColumnarCacheHeader::kColumnCount;
+    header.rowCount = data.size();
+    header.rowsRejected = report.rowsRejected;
+    header.source = source;
+    header.encoding = static_cast<uint32_t>(encoding);
+    header.blockRows = encoding == CacheEncoding::Gorilla ? ColumnarCacheHeader::kDefaultBlockRows : 0;
+    if (!data.empty()) {
+        auto [minIt, maxIt] = std::minmax_element(data.getTimestamps().begin(), data.getTimestamps().end());
+        header.minTimestamp = *minIt;
+        header.maxTimestamp = *maxIt;
+    }
+
+    uint64_t offset = sizeof(ColumnarCacheHeader);
+    for (uint32_t c = 0; c < ColumnarCacheHeader::kColumnCount; ++c) {
+        offset = alignUp(offset, kCacheLineSize);
+        header.columnOffsets[c] = offset;
+        header.columnBytes[c] = columnBytes[c];
+        offset += header.columnBytes[c];
+    }
+    header.headerChecksum = headerChecksum(header);
+
+    // Write under a unique temporary name and rename into place, so concurrent
+    // writers and readers never observe a half-written cache. The name keeps the
+    // .fgc extension so that directory listings skipping caches skip it too.
+    std::string tempPath = cachePath + ".tmp." + std::to_string(::getpid()) + "." +
+                           std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".fgc";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        static const char kPadding[kCacheLineSize] = {};
+        uint64_t written = sizeof(header);
+        for (uint32_t c = 0; c < ColumnarCacheHeader::kColumnCount; ++c) {
+            out.write(kPadding, static_cast<std::streamsize>(header.columnOffsets[c] - written));
+            out.write(static_cast<const char*>(columns[c]), static_cast<std::streamsize>(header.columnBytes[c]));
+            written = header.columnOffsets[c] + header.columnBytes[c];
+        }
+        if (!out.good()) {
+            out.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ColumnarCache::open(const std::string& cachePath, const FileFingerprint& expectedSource,
+                         std::shared_ptr<const void>& storage, MarketDataView& view, LoadReport& report) {
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(cachePath) || file->size() < sizeof(ColumnarCacheHeader)) {
+        return false;
+    }
+
+    ColumnarCacheHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (!validateHeader(header, file->size(), expectedSource)) {
+        return false;
+    }
+
+    const char* base = file->data();
+    if (header.encoding == static_cast<uint32_t>(CacheEncoding::Gorilla)) {
+        auto columns = std::make_shared<ColumnBuffers>();
+        if (!decodeColumns(base, header, *columns)) {
+            return false;
+        }
+        view = MarketDataView(*columns);
+        storage = std::move(columns);
+    } else {
+        view = MarketDataView(
+            reinterpret_cast<const int64_t*>(base + header.columnOffsets[0]),
+            reinterpret_cast<const double*>(base + header.columnOffsets[1]),
+            reinterpret_cast<const double*>(base + header.columnOffsets[2]),
+            reinterpret_cast<const double*>(base + header.columnOffsets[3]),
+            reinterpret_cast<const double*>(base + header.columnOffsets[4]),
+            reinterpret_cast<const uint64_t*>(base + header.columnOffsets[5]),
+            static_cast<size_t>(header.rowCount));
+        storage = std::move(file);
+    }
+
+    report = LoadReport{};
+    report.rowsLoaded = static_cast<size_t>(header.rowCount);
+    report.rowsRejected = static_cast<size_t>(header.rowsRejected);
+    return true;
+}
+
+bool ColumnarCache::validateHeader(const ColumnarCacheHeader& header, uint64_t fileSize,
+                                   const FileFingerprint& expectedSource) {
+    if (header.magic != ColumnarCacheHeader::kMagic ||
+        header.version != ColumnarCacheHeader::kVersion ||
+        header.byteOrderMark != ColumnarCacheHeader::kByteOrderMark ||
+        header.headerSize != sizeof(ColumnarCacheHeader) ||
+        header.columnCount != ColumnarCacheHeader::kColumnCount ||
+        header.headerChecksum != headerChecksum(header) ||
+        !(header.source == expectedSource)) {
+        return false;
+    }
+    bool compressed = header.encoding == static_cast<uint32_t>(CacheEncoding::Gorilla);
+    if (!compressed && header.encoding != static_cast<uint32_t>(CacheEncoding::Raw)) {
+        return false;
+    }
+    if (compressed && header.blockRows == 0) {
+        return false;
+    }
+
+    // Every column must be aligned, inside the file and of the expected length:
+    // exact for raw arrays, at least the block directory for compressed ones
+    for (uint32_t c = 0; c < ColumnarCacheHeader::kColumnCount; ++c) {
+        bool sized = compressed
+            ? header.columnBytes[c] >= (blockCount(header) + 1) * sizeof(uint64_t)
+            : header.columnBytes[c] == kElementSize[c] * header.rowCount;
+        if (header.columnOffsets[c] % kCacheLineSize != 0 || !sized ||
+            header.columnOffsets[c] + header.columnBytes[c] > fileSize) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ColumnarCache::decodeBlock(uint32_t column, const uint8_t* data, size_t size,
+                                size_t rows, ColumnBuffers& out, size_t at) {
+    switch (column) {
+    case 0: return GorillaCodec::decodeTimestamps(data, size, rows, out.timestamps.data() + at);
+    case 1: return GorillaCodec::decodeDoubles(data, size, rows, out.open.data() + at);
+    case 2: return GorillaCodec::decodeDoubles(data, size, rows, out.high.data() + at);
+    case 3: return GorillaCodec::decodeDoubles(data, size, rows, out.low.data() + at);
+    case 4: return GorillaCodec::decodeDoubles(data, size, rows, out.close.data() + at);
+    case 5: return GorillaCodec::decodeVarints(data, size, rows, out.volume.data() + at);
+    default: return false;
+    }
+}
+
+} // namespace fingraph
@@ -0,0 +1,29 @@
+#include "fingraph/CostModel.h"
+#include <stdexcept>
+
+namespace fingraph {
+
+TransactionCosts transactionCostsFromParameters(const std::map<std::string, double>& params) {
+    auto read = [&params](const char* name, double scale) {
+        auto it = params.find(name);
+        if (it == params.end()) {
+            return 0.0;
+        }
+        if (!(it->second >= 0)) {
+            throw std::invalid_argument(std::string(name) + " must be non-negative");
+        }
+        return it->second * scale;
+    };
+    const double bps = 1e-4;
+    TransactionCosts costs;
+    Commission& commission = costs;
+    commission.perTrade = read("commissionPerTrade", 1.0);
+    commission.perShare = read("commissionPerShare", 1.0);
+    commission.rate = read("commissionBps", bps);
+    static_cast<Spread&>(costs).spread = read("spreadBps", bps);
+    static_cast<Slippage&>(costs).rate = read("slippageBps", bps);
+    static_cast<MarketImpact&>(costs).coefficient = read("impactCoefficient", 1.0);
+    return costs;
+}
+
+} // namespace fingraph
@@ -0,0 +1,396 @@
+#include "fingraph/CsvParser.h"
+#include "fingraph/ThreadPool.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace fingraph {
+
+namespace {
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's algorithm).
+// Out-of-range days roll over exactly like mktime does (e.g. Feb 30 -> Mar 2).
+constexpr int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+// Decodes two ASCII digits; `bad` accumulates a non-zero value on any non-digit.
+inline unsigned twoDigits(const char* p, unsigned& bad) {
+    unsigned a = static_cast<unsigned char>(p[0]) - '0';
+    unsigned b = static_cast<unsigned char>(p[1]) - '0';
+    bad |= (a > 9) | (b > 9);
+    return a * 10 + b;
+}
+
+inline const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        ++p;
+    }
+    return p;
+}
+
+// Field readers consume one field starting at `p` and leave `p` just past the
+// terminating comma (or at `end` for the last field on the line).
+inline bool endField(const char*& p, const char* end) {
+    p = skipSpaces(p, end);
+    if (p == end) {
+        return true;
+    }
+    if (*p != ',') {
+        return false;
+    }
+    ++p;
+    return true;
+}
+
+// Exact fast path for plain decimals such as "101.2500": when the digits fit in a
+// 53-bit mantissa and there are at most 22 fraction digits, one IEEE division by an
+// exactly representable power of ten is correctly rounded (Clinger), so the result
+// is bit-identical to strtod. Anything else returns false and takes the slow path.
+inline bool readPlainDecimal(const char*& p, const char* end, double& value) {
+    static constexpr double kPow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char* q = p;
+    bool negative = q < end && *q == '-';
+    q += negative;
+    const char* digitsBegin = q;
+    uint64_t mantissa = 0;
+    while (q < end && static_cast<unsigned>(*q - '0') <= 9) {
+        mantissa = mantissa * 10 + static_cast<unsigned>(*q - '0');
+        ++q;
+    }
+    size_t intDigits = static_cast<size_t>(q - digitsBegin);
+    size_t fracDigits = 0;
+    if (q < end && *q == '.') {
+        const char* fracBegin = ++q;
+        while (q < end && static_cast<unsigned>(*q - '0') <= 9) {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*q - '0');
+            ++q;
+        }
+        fracDigits = static_cast<size_t>(q - fracBegin);
+    }
+    if (intDigits + fracDigits == 0 || intDigits + fracDigits > 19 || fracDigits > 22 ||
+        mantissa > (uint64_t(1) << 53) || (q < end && (*q == 'e' || *q == 'E'))) {
+        return false;
+    }
+    double result = static_cast<double>(mantissa) / kPow10[fracDigits];
+    value = negative ? -result : result;
+    p = q;
+    return true;
+}
+
+bool readDouble(const char*& p, const char* end, double& value) {
+    const char* first = skipSpaces(p, end);
+    if (first < end && *first == '+') {
+        ++first;
+    }
+    if (readPlainDecimal(first, end, value)) {
+        p = first;
+        return endField(p, end);
+    }
+#if defined(__cpp_lib_to_chars)
+    auto [ptr, ec] = std::from_chars(first, end, value);
+    if (ec != std::errc() || ptr == first) {
+        return false;
+    }
+#else
+    // Standard libraries without floating-point from_chars: strtod on a bounded copy.
+    char buffer[64];
+    const char* comma = static_cast<const char*>(std::memchr(first, ',', static_cast<size_t>(end - first)));
+    size_t length = static_cast<size_t>((comma ? comma : end) - first);
+    if (length == 0 || length >= sizeof(buffer)) {
+        return false;
+    }
+    std::memcpy(buffer, first, length);
+    buffer[length] = '\0';
+    char* endPtr = nullptr;
+    value = std::strtod(buffer, &endPtr);
+    if (endPtr == buffer) {
+        return false;
+    }
+    const char* ptr = first + (endPtr - buffer);
+#endif
+    p = ptr;
+    return endField(p, end);
+}
+
+bool readVolume(const char*& p, const char* end, uint64_t& value) {
+    const char* first = skipSpaces(p, end);
+    if (first < end && *first == '+') {
+        ++first;
+    }
+    auto [ptr, ec] = std::from_chars(first, end, value);
+    if (ec != std::errc() || ptr == first) {
+        return false;
+    }
+    // Some vendors publish volume as "1234.0"; the fractional part is truncated.
+    if (ptr < end && *ptr == '.') {
+        ++ptr;
+        while (ptr < end && static_cast<unsigned>(*ptr - '0') <= 9) {
+            ++ptr;
+        }
+    }
+    p = ptr;
+    return endField(p, end);
+}
+
+} // namespace
+
+bool CsvParser::parseTimestamp(std::string_view text, int64_t& epochSeconds) {
+    const char* p = text.data();
+    size_t n = text.size();
+    while (n > 0 && (p[n - 1] == ' ' || p[n - 1] == 'Z')) {
+        --n;
+    }
+    if (n < 10 || p[4] != '-' || p[7] != '-') {
+        return false;
+    }
+
+    unsigned bad = 0;
+    unsigned year = twoDigits(p, bad) * 100 + twoDigits(p + 2, bad);
+    unsigned month = twoDigits(p + 5, bad);
+    unsigned day = twoDigits(p + 8, bad);
+    bad |= (month - 1 > 11) | (day - 1 > 30);
+
+    unsigned hour = 0, minute = 0, second = 0;
+    if (n > 10) {
+        // Time of day: [ T]HH:MM[:SS[.fff]]
+        if (n < 16 || (p[10] != ' ' && p[10] != 'T') || p[13] != ':') {
+            return false;
+        }
+        hour = twoDigits(p + 11, bad);
+        minute = twoDigits(p + 14, bad);
+        size_t pos = 16;
+        if (pos < n) {
+            if (n < 19 || p[16] != ':') {
+                return false;
+            }
+            second = twoDigits(p + 17, bad);
+            pos = 19;
+            if (pos < n) {
+                // Sub-second precision is accepted but truncated
+                if (p[pos] != '.') {
+                    return false;
+                }
+                for (++pos; pos < n; ++pos) {
+                    bad |= static_cast<unsigned>(static_cast<unsigned char>(p[pos]) - '0') > 9;
+                }
+            }
+        }
+        bad |= (hour > 23) | (minute > 59) | (second > 60);
+    }
+
+    if (bad) {
+        return false;
+    }
+
+    epochSeconds = daysFromCivil(year, month, day) * 86400
+                 + static_cast<int64_t>(hour * 3600 + minute * 60 + second);
+    return true;
+}
+
+namespace {
+
+// Shared by parseRow and parseRows: decodes one row straight into scalars so the
+// bulk path can append to columns without building an OHLCV first.
+bool parseFields(const char* p, const char* end, int64_t& epochSeconds, double (&prices)[4],
+                 uint64_t& volume, const char*& error) {
+    if (p < end && end[-1] == '\r') {
+        --end;
+    }
+
+    // The timestamp is the only field whose end is not found by its own decoder.
+    // Date-only stamps are by far the most common layout, so check that first.
+    const char* comma = (end - p > 10 && p[10] == ',')
+        ? p + 10
+        : static_cast<const char*>(std::memchr(p, ',', static_cast<size_t>(end - p)));
+    if (!comma || !CsvParser::parseTimestamp(std::string_view(p, static_cast<size_t>(comma - p)), epochSeconds)) {
+        error = comma ? "failed to parse timestamp" : "expected 6 comma-separated fields";
+        return false;
+    }
+    p = comma + 1;
+
+    // Each price must be followed by a comma; the volume may end the line or be
+    // followed by further columns, which are ignored.
+    static const char* const kPriceErrors[4] = {
+        "failed to parse open", "failed to parse high", "failed to parse low", "failed to parse close"};
+    for (int f = 0; f < 4; ++f) {
+        if (!readDouble(p, end, prices[f])) {
+            error = kPriceErrors[f];
+            return false;
+        }
+        if (p == end) {
+            error = "expected 6 comma-separated fields";
+            return false;
+        }
+    }
+    if (!readVolume(p, end, volume)) {
+        error = "failed to parse volume";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool CsvParser::parseRow(std::string_view line, OHLCV& bar, const char*& error) {
+    int64_t epochSeconds = 0;
+    double prices[4];
+    if (!parseFields(line.data(), line.data() + line.size(), epochSeconds, prices, bar.volume, error)) {
+        return false;
+    }
+    bar.timestamp = toTimePoint(epochSeconds);
+    bar.open = prices[0];
+    bar.high = prices[1];
+    bar.low = prices[2];
+    bar.close = prices[3];
+    return true;
+}
+
+size_t CsvParser::parseRows(std::string_view text, size_t firstLineNumber,
+                            ColumnBuffers& out, LoadReport& report) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    size_t lineNumber = firstLineNumber;
+
+    while (p < end) {
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        const char* lineEnd = newline ? newline : end;
+
+        if (lineEnd > p && !(lineEnd - p == 1 && *p == '\r')) {
+            int64_t epochSeconds;
+            double prices[4];
+            uint64_t volume;
+            const char* error = nullptr;
+            if (parseFields(p, lineEnd, epochSeconds, prices, volume, error)) {
+                out.append(epochSeconds, prices[0], prices[1], prices[2], prices[3], volume);
+            } else {
+                report.addError(lineNumber, error, std::string_view(p, static_cast<size_t>(lineEnd - p)));
+            }
+        }
+
+        p = lineEnd + 1;
+        ++lineNumber;
+    }
+    return lineNumber - firstLineNumber;
+}
+
+void CsvParser::parseRowsParallel(std::string_view text, size_t firstLineNumber,
+                                  ColumnBuffers& out, LoadReport& report,
+                                  ThreadPool& pool, size_t chunkCount) {
+    chunkCount = std::min(chunkCount, text.size());
+    if (chunkCount <= 1) {
+        parseRows(text, firstLineNumber, out, report);
+        return;
+    }
+
+    // Cut at even offsets, then move each cut forward to just past the next newline
+    std::vector<size_t> bounds(chunkCount + 1, text.size());
+    bounds[0] = 0;
+    for (size_t i = 1; i < chunkCount; ++i) {
+        size_t cut = std::max(bounds[i - 1], text.size() / chunkCount * i);
+        if (cut > 0 && text[cut - 1] != '\n') {
+            size_t newline = text.find('\n', cut);
+            cut = newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+        bounds[i] = cut;
+    }
+
+    struct Chunk {
+        ColumnBuffers columns;
+        LoadReport report; // Line numbers relative to the start of the chunk
+        size_t lines = 0;
+    };
+    std::vector<Chunk> chunks(chunkCount);
+
+    // Every task references `chunks`, so wait for all of them before rethrowing
+    auto runAll = [&](auto&& task) {
+        std::vector<std::future<void>> pending;
+        pending.reserve(chunkCount);
+        for (size_t i = 0; i < chunkCount; ++i) {
+            pending.push_back(pool.submit([&task, i] { task(i); }));
+        }
+        for (auto& f : pending) {
+            f.wait();
+        }
+        for (auto& f : pending) {
+            f.get();
+        }
+    };
+
+    runAll([&](size_t i) {
+        std::string_view piece = text.substr(bounds[i], bounds[i + 1] - bounds[i]);
+        Chunk& chunk = chunks[i];
+        chunk.columns.reserve(estimateRowCount(piece));
+        chunk.lines = parseRows(piece, 0, chunk.columns, chunk.report);
+    });
+
+    // Stitch in file order: offsets and error line numbers follow from the chunks before
+    std::vector<size_t> offsets(chunkCount);
+    size_t total = out.size();
+    size_t lineNumber = firstLineNumber;
+    for (size_t i = 0; i < chunkCount; ++i) {
+        offsets[i] = total;
+        total += chunks[i].columns.size();
+        for (auto& error : chunks[i].report.errors) {
+            error.line += lineNumber;
+        }
+        report.merge(chunks[i].report);
+        lineNumber += chunks[i].lines;
+    }
+
+    out.timestamps.resize(total);
+    out.open.resize(total);
+    out.high.resize(total);
+    out.low.resize(total);
+    out.close.resize(total);
+    out.volume.resize(total);
+    runAll([&](size_t i) {
+        ColumnBuffers& piece = chunks[i].columns;
+        size_t at = offsets[i];
+        std::copy(piece.timestamps.begin(), piece.timestamps.end(), out.timestamps.begin() + at);
+        std::copy(piece.open.begin(), piece.open.end(), out.open.begin() + at);
+        std::copy(piece.high.begin(), piece.high.end(), out.high.begin() + at);
+        std::copy(piece.low.begin(), piece.low.end(), out.low.begin() + at);
+        std::copy(piece.close.begin(), piece.close.end(), out.close.begin() + at);
+        std::copy(piece.volume.begin(), piece.volume.end(), out.volume.begin() + at);
+        piece = ColumnBuffers{}; // Release the chunk as soon as it is copied
+    });
+}
+
+size_t CsvParser::skipHeader(std::string_view text) {
+    size_t newline = text.find('\n');
+    return newline == std::string_view::npos ? text.size() : newline + 1;
+}
+
+size_t CsvParser::estimateRowCount(std::string_view text) {
+    constexpr size_t kSampleLines = 64;
+    size_t pos = 0;
+    size_t lines = 0;
+    while (lines < kSampleLines && pos < text.size()) {
+        size_t newline = text.find('\n', pos);
+        if (newline == std::string_view::npos) {
+            pos = text.size();
+        } else {
+            pos = newline + 1;
+        }
+        ++lines;
+    }
+    if (lines == 0) {
+        return 0;
+    }
+    // Pad the estimate slightly so that longer rows later on rarely force a regrow.
+    size_t averageLength = pos / lines;
+    return text.size() / averageLength + text.size() / averageLength / 32 + 1;
+}
+
+} // namespace fingraph
@@ -1,4 +1,5 @@
 #include "fingraph/DatabaseService.h"
+#include "fingraph/MarketData.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -139,14 +140,19 @@ bool DatabaseService::saveJob(const JobRecord& job) {
         return false;
     }
     
-    // Bind parameters
+    // Bind parameters; bound text must outlive the step, so keep the formatted values in scope
+    std::string request_data = jsonToString(job.request_data);
+    std::string result_data = jsonToString(job.result_data);
+    std::string created_at = timePointToString(job.created_at);
+    std::string started_at = timePointToString(job.started_at);
+    std::string completed_at = timePointToString(job.completed_at);
     sqlite3_bind_text(stmt, 1, job.id.c_str(), -1, SQLITE_STATIC);
     sqlite3_bind_text(stmt, 2, job.status.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 3, jsonToString(job.request_data).c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 4, jsonToString(job.result_data).c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 5, timePointToString(job.created_at).c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 6, timePointToString(job.started_at).c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 7, timePointToString(job.completed_at).c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, request_data.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 4, result_data.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 5, created_at.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 6, started_at.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 7, completed_at.c_str(), -1, SQLITE_STATIC);
     sqlite3_bind_text(stmt, 8, job.error_message.c_str(), -1, SQLITE_STATIC);
     
     rc = sqlite3_step(stmt);
@@ -272,8 +278,9 @@ bool DatabaseService::updateJobResult(const std::string& job_id, const json& res
         return false;
     }
     
+    std::string result_data = jsonToString(result);
     std::string now = timePointToString(std::chrono::system_clock::now());
-    sqlite3_bind_text(stmt, 1, jsonToString(result).c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 1, result_data.c_str(), -1, SQLITE_STATIC);
     sqlite3_bind_text(stmt, 2, now.c_str(), -1, SQLITE_STATIC);
     sqlite3_bind_text(stmt, 3, job_id.c_str(), -1, SQLITE_STATIC);
     
@@ -341,8 +348,10 @@ bool DatabaseService::saveMarketData(const std::vector<MarketDataRecord>& record
     
     bool success = true;
     for (const auto& record : records) {
+        // Bound text must outlive the step, so keep the formatted timestamp in scope
+        std::string timestamp = timePointToString(record.timestamp);
         sqlite3_bind_text(stmt, 1, record.symbol.c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_text(stmt, 2, timePointToString(record.timestamp).c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 2, timestamp.c_str(), -1, SQLITE_STATIC);
         sqlite3_bind_double(stmt, 3, record.open_price);
         sqlite3_bind_double(stmt, 4, record.high_price);
         sqlite3_bind_double(stmt, 5, record.low_price);
@@ -408,6 +417,61 @@ std::vector<MarketDataRecord> DatabaseService::getMarketData(
     return records;
 }
 
+bool DatabaseService::loadMarketData(const std::string& symbol, int64_t start_seconds, int64_t end_seconds,
+                                     MarketData& out) {
+    // The timestamp text is converted to epoch seconds by SQLite itself, and the
+    // range is compared as text so the (symbol, timestamp) index still applies.
+    std::string query = "SELECT CAST(strftime('%s', timestamp) AS INTEGER), "
+                        "open_price, high_price, low_price, close_price, volume "
+                        "FROM market_data WHERE symbol = ?";
+    if (start_seconds != 0) {
+        query += " AND timestamp >= ?";
+    }
+    if (end_seconds != 0) {
+        query += " AND timestamp <= ?";
+    }
+    query += " ORDER BY timestamp";
+
+    sqlite3_stmt* stmt;
+    int rc = sqlite3_prepare_v2(pimpl_->db, query.c_str(), -1, &stmt, nullptr);
+    if (rc != SQLITE_OK) {
+        std::cerr << "Failed to prepare statement: " << sqlite3_errmsg(pimpl_->db) << std::endl;
+        return false;
+    }
+
+    std::string start_str = timePointToString(toTimePoint(start_seconds));
+    std::string end_str = timePointToString(toTimePoint(end_seconds));
+    int param = 1;
+    sqlite3_bind_text(stmt, param++, symbol.c_str(), -1, SQLITE_STATIC);
+    if (start_seconds != 0) {
+        sqlite3_bind_text(stmt, param++, start_str.c_str(), -1, SQLITE_STATIC);
+    }
+    if (end_seconds != 0) {
+        sqlite3_bind_text(stmt, param++, end_str.c_str(), -1, SQLITE_STATIC);
+    }
+
+    ColumnBuffers columns;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        if (sqlite3_column_type(stmt, 0) == SQLITE_NULL) {
+            continue;
+        }
+        columns.append(sqlite3_column_int64(stmt, 0),
+                       sqlite3_column_double(stmt, 1),
+                       sqlite3_column_double(stmt, 2),
+                       sqlite3_column_double(stmt, 3),
+                       sqlite3_column_double(stmt, 4),
+                       static_cast<uint64_t>(sqlite3_column_int64(stmt, 5)));
+    }
+    sqlite3_finalize(stmt);
+    if (rc != SQLITE_DONE) {
+        std::cerr << "Failed to read market data: " << sqlite3_errmsg(pimpl_->db) << std::endl;
+        return false;
+    }
+
+    out.assign(std::move(columns));
+    return true;
+}
+
 std::vector<std::string> DatabaseService::getAvailableSymbols() {
     std::string query = "SELECT DISTINCT symbol FROM market_data ORDER BY symbol";
     
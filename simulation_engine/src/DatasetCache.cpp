@@ -0,0 +1,118 @@
+#include "fingraph/DatasetCache.h"
+#include "fingraph/FileFingerprint.h"
+#include "fingraph/Resampler.h"
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+namespace fingraph {
+
+DatasetCache::DatasetCache(size_t byte_budget)
+    : cache_(byte_budget, [](const std::string&, const DatasetPtr& dataset) { return dataset->getMemoryUsage(); }) {
+}
+
+void DatasetCache::identify(const std::string& file_path, std::string& canonical_path, std::string& version,
+                            uint64_t& sequence) {
+    std::error_code ec;
+    canonical_path = std::filesystem::canonical(file_path, ec).string();
+    FileFingerprint fingerprint;
+    if (ec || !FileFingerprint::compute(canonical_path, fingerprint)) {
+        throw std::runtime_error("Failed to load market data from " + file_path);
+    }
+    version = canonical_path + "#" + std::to_string(fingerprint.combined());
+    sequence = ++next_sequence_;
+}
+
+std::shared_ptr<const MarketData> DatasetCache::get(const std::string& file_path) {
+    std::string canonical_path, version;
+    uint64_t sequence;
+    identify(file_path, canonical_path, version, sequence);
+    return getSource(canonical_path, version, sequence);
+}
+
+DatasetCache::DatasetPtr DatasetCache::getSource(const std::string& canonical_path, const std::string& version,
+                                                 uint64_t sequence) {
+    return getOrLoad(version, canonical_path, version, sequence, [&]() -> DatasetPtr {
+        auto market_data = std::make_shared<MarketData>();
+        if (!market_data->loadFromCSV(canonical_path)) {
+            throw std::runtime_error("Failed to load market data from " + canonical_path);
+        }
+        return market_data;
+    });
+}
+
+std::shared_ptr<const MarketData> DatasetCache::get(const std::string& file_path, int64_t bar_seconds) {
+    std::string dataset_key;
+    return get(file_path, bar_seconds, dataset_key);
+}
+
+std::shared_ptr<const MarketData> DatasetCache::get(const std::string& file_path, int64_t bar_seconds,
+                                                    std::string& dataset_key) {
+    std::string canonical_path, version;
+    uint64_t sequence;
+    identify(file_path, canonical_path, version, sequence);
+    if (bar_seconds == 0) {
+        dataset_key = version;
+        return getSource(canonical_path, version, sequence);
+    }
+    std::string key = version + "@" + std::to_string(bar_seconds) + "s";
+    dataset_key = key;
+    return getOrLoad(key, canonical_path, version, sequence, [&]() -> DatasetPtr {
+        DatasetPtr source = getSource(canonical_path, version, sequence);
+        ColumnBuffers columns;
+        Resampler::resample(source->getView(), bar_seconds, columns);
+        auto resampled = std::make_shared<MarketData>();
+        resampled->assign(std::move(columns));
+        return resampled;
+    });
+}
+
+DatasetCache::DatasetPtr DatasetCache::getOrLoad(const std::string& key, const std::string& canonical_path,
+                                                 const std::string& version, uint64_t sequence,
+                                                 const std::function<DatasetPtr()>& load) {
+    return cache_.get(key, load, [&](const std::string&) {
+        std::lock_guard<std::mutex> lock(versions_mutex_);
+        Latest& latest = latest_by_path_[canonical_path];
+        if (latest.version != version) {
+            if (sequence < latest.sequence) {
+                // The file was seen at a newer version while this one loaded: keep the
+                // newer entries and let this load's callers have their dataset uncached
+                return false;
+            }
+            // A newer version of a file supersedes everything cached from older ones
+            std::string prefix = canonical_path + "#";
+            cache_.evictLocked([&](const std::string& cached) {
+                return cached.compare(0, prefix.size(), prefix) == 0 &&
+                       cached.find('#', prefix.size()) == std::string::npos;
+            });
+            latest.version = version;
+        }
+        latest.sequence = std::max(latest.sequence, sequence);
+        return true;
+    });
+}
+
+DatasetCacheStats DatasetCache::getStats() const {
+    SingleFlightLruCacheStats cached = cache_.getStats();
+    DatasetCacheStats stats;
+    stats.hits = cached.hits;
+    stats.misses = cached.misses;
+    stats.evictions = cached.evictions;
+    stats.load_failures = cached.failures;
+    stats.entries = cached.entries;
+    stats.bytes_in_use = cached.bytes_in_use;
+    stats.byte_budget = cached.byte_budget;
+    return stats;
+}
+
+void DatasetCache::setByteBudget(size_t byte_budget) {
+    cache_.setByteBudget(byte_budget);
+}
+
+void DatasetCache::clear() {
+    cache_.clear();
+    std::lock_guard<std::mutex> lock(versions_mutex_);
+    latest_by_path_.clear();
+}
+
+} // namespace fingraph
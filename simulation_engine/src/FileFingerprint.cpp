@@ -0,0 +1,68 @@
+#include "fingraph/FileFingerprint.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+namespace fingraph {
+
+uint64_t fnv1a64(const void* data, size_t size, uint64_t seed) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool FileFingerprint::compute(const std::string& filePath, FileFingerprint& out) {
+    constexpr size_t kSampleSize = 64 * 1024;
+
+    std::error_code ec;
+    auto size = std::filesystem::file_size(filePath, ec);
+    if (ec) {
+        return false;
+    }
+    auto mtime = std::filesystem::last_write_time(filePath, ec);
+    if (ec) {
+        return false;
+    }
+
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Hash the head and the tail; appends and in-place edits near either end are
+    // the common ways a data file changes without its size changing much.
+    std::vector<char> buffer(kSampleSize);
+    uint64_t hash = fnv1a64(nullptr, 0);
+    size_t headBytes = static_cast<size_t>(std::min<uintmax_t>(size, kSampleSize));
+    file.read(buffer.data(), static_cast<std::streamsize>(headBytes));
+    hash = fnv1a64(buffer.data(), static_cast<size_t>(file.gcount()), hash);
+    if (size > kSampleSize) {
+        size_t tailBytes = static_cast<size_t>(std::min<uintmax_t>(size - kSampleSize, kSampleSize));
+        file.seekg(static_cast<std::streamoff>(size - tailBytes));
+        file.read(buffer.data(), static_cast<std::streamsize>(tailBytes));
+        hash = fnv1a64(buffer.data(), static_cast<size_t>(file.gcount()), hash);
+    }
+    if (file.bad()) {
+        return false;
+    }
+
+    out.size = static_cast<uint64_t>(size);
+    out.mtimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count();
+    out.sampleHash = hash;
+    return true;
+}
+
+uint64_t FileFingerprint::combined() const {
+    uint64_t hash = fnv1a64(&size, sizeof(size));
+    hash = fnv1a64(&mtimeNs, sizeof(mtimeNs), hash);
+    return fnv1a64(&sampleHash, sizeof(sampleHash), hash);
+}
+
+} // namespace fingraph
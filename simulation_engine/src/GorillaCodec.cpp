@@ -0,0 +1,343 @@
+#include "fingraph/GorillaCodec.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace fingraph {
+
+namespace {
+
+// Maps small negative and positive integers (two's complement) to small unsigned ones.
+constexpr uint64_t zigzag(uint64_t value) {
+    return (value << 1) ^ (uint64_t(0) - (value >> 63));
+}
+
+constexpr uint64_t unzigzag(uint64_t value) {
+    return (value >> 1) ^ (uint64_t(0) - (value & 1));
+}
+
+// Appends bits most significant first.
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    // Appends the low `n` bits of `value`, 1 <= n <= 64.
+    void write(uint64_t value, int n) {
+        if (n > 32) {
+            write(value >> 32, n - 32);
+            n = 32;
+        }
+        value &= (uint64_t(1) << n) - 1;
+        pending_ = (pending_ << n) | value;
+        count_ += n;
+        while (count_ >= 8) {
+            count_ -= 8;
+            out_.push_back(static_cast<uint8_t>(pending_ >> count_));
+        }
+    }
+
+    // Pads the last partial byte with zero bits.
+    void flush() {
+        if (count_ > 0) {
+            out_.push_back(static_cast<uint8_t>(pending_ << (8 - count_)));
+            count_ = 0;
+        }
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+    uint64_t pending_ = 0; // The low count_ bits are not yet written
+    int count_ = 0;
+};
+
+// Reads what BitWriter wrote. Reading past the end yields zeros and sets failed().
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    // Reads `n` bits, 1 <= n <= 64.
+    uint64_t read(int n) {
+        if (n > 56) {
+            uint64_t high = read(n - 32);
+            return (high << 32) | read(32);
+        }
+        if (position_ + static_cast<size_t>(n) > size_ * 8) {
+            failed_ = true;
+            position_ = size_ * 8;
+            return 0;
+        }
+        // Big-endian load of the 8 bytes holding the next bits (zero padded at the end)
+        size_t byte = position_ >> 3;
+        uint64_t word = 0;
+        if (byte + 8 <= size_) {
+            const uint8_t* p = data_ + byte;
+            word = (uint64_t(p[0]) << 56) | (uint64_t(p[1]) << 48) | (uint64_t(p[2]) << 40) |
+                   (uint64_t(p[3]) << 32) | (uint64_t(p[4]) << 24) | (uint64_t(p[5]) << 16) |
+                   (uint64_t(p[6]) << 8) | uint64_t(p[7]);
+        } else {
+            for (size_t i = 0; i < 8; ++i) {
+                word = (word << 8) | (byte + i < size_ ? data_[byte + i] : 0);
+            }
+        }
+        uint64_t value = (word << (position_ & 7)) >> (64 - n);
+        position_ += static_cast<size_t>(n);
+        return value;
+    }
+
+    bool readBit() { return read(1) != 0; }
+    bool failed() const { return failed_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t position_ = 0; // In bits
+    bool failed_ = false;
+};
+
+void writeVarint(uint64_t value, std::vector<uint8_t>& out) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool readVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        value |= uint64_t(byte & 0x7f) << shift;
+        if (byte < 0x80) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// First byte of an encoded block of doubles.
+enum DoubleMode : uint8_t {
+    kModeXor = 0,
+    kModeDecimal = 1,
+};
+
+constexpr int kMaxDecimals = 8;
+constexpr double kPowersOf10[kMaxDecimals + 1] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8};
+
+// True if `value` is exactly mantissa / scale for an integer mantissa, i.e. it
+// decodes back to the very same bits.
+bool toScaledInteger(double value, double scale, int64_t& mantissa) {
+    double scaled = value * scale;
+    if (!(std::fabs(scaled) < 9007199254740992.0)) { // 2^53; also rejects NaN
+        return false;
+    }
+    mantissa = static_cast<int64_t>(std::nearbyint(scaled));
+    return std::bit_cast<uint64_t>(static_cast<double>(mantissa) / scale) == std::bit_cast<uint64_t>(value);
+}
+
+// Finds the fewest decimals that represent every value exactly.
+bool toDecimals(std::span<const double> values, int& decimals, std::vector<int64_t>& mantissas) {
+    decimals = 0;
+    int64_t mantissa;
+    for (double value : values) {
+        while (!toScaledInteger(value, kPowersOf10[decimals], mantissa)) {
+            if (++decimals > kMaxDecimals) {
+                return false;
+            }
+        }
+    }
+    // A value exact at fewer decimals is almost always exact at more; confirm it
+    mantissas.resize(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!toScaledInteger(values[i], kPowersOf10[decimals], mantissas[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void GorillaCodec::encodeTimestamps(std::span<const int64_t> values, std::vector<uint8_t>& out) {
+    if (values.empty()) {
+        return;
+    }
+    BitWriter writer(out);
+    writer.write(static_cast<uint64_t>(values[0]), 64);
+
+    // Unsigned arithmetic: deltas wrap rather than overflow, and unwrap identically
+    uint64_t previous = static_cast<uint64_t>(values[0]);
+    uint64_t previousDelta = 0;
+    for (size_t i = 1; i < values.size(); ++i) {
+        uint64_t delta = static_cast<uint64_t>(values[i]) - previous;
+        uint64_t dod = zigzag(delta - previousDelta);
+        if (dod == 0) {
+            writer.write(0b0, 1);
+        } else if (dod < (uint64_t(1) << 7)) {
+            writer.write(0b10, 2);
+            writer.write(dod, 7);
+        } else if (dod < (uint64_t(1) << 12)) {
+            writer.write(0b110, 3);
+            writer.write(dod, 12);
+        } else if (dod < (uint64_t(1) << 20)) { // Covers weekend and holiday gaps in daily bars
+            writer.write(0b1110, 4);
+            writer.write(dod, 20);
+        } else {
+            writer.write(0b1111, 4);
+            writer.write(dod, 64);
+        }
+        previousDelta = delta;
+        previous = static_cast<uint64_t>(values[i]);
+    }
+    writer.flush();
+}
+
+bool GorillaCodec::decodeTimestamps(const uint8_t* data, size_t size, size_t count, int64_t* out) {
+    if (count == 0) {
+        return true;
+    }
+    BitReader reader(data, size);
+    uint64_t previous = reader.read(64);
+    uint64_t previousDelta = 0;
+    out[0] = static_cast<int64_t>(previous);
+    for (size_t i = 1; i < count; ++i) {
+        uint64_t dod = 0;
+        if (reader.readBit()) {
+            if (!reader.readBit()) {
+                dod = reader.read(7);
+            } else if (!reader.readBit()) {
+                dod = reader.read(12);
+            } else if (!reader.readBit()) {
+                dod = reader.read(20);
+            } else {
+                dod = reader.read(64);
+            }
+        }
+        previousDelta += unzigzag(dod);
+        previous += previousDelta;
+        out[i] = static_cast<int64_t>(previous);
+    }
+    return !reader.failed();
+}
+
+void GorillaCodec::encodeDoubles(std::span<const double> values, std::vector<uint8_t>& out) {
+    if (values.empty()) {
+        return;
+    }
+
+    int decimals;
+    std::vector<int64_t> mantissas;
+    if (toDecimals(values, decimals, mantissas)) {
+        out.push_back(kModeDecimal);
+        out.push_back(static_cast<uint8_t>(decimals));
+        uint64_t previous = 0;
+        for (int64_t mantissa : mantissas) {
+            writeVarint(zigzag(static_cast<uint64_t>(mantissa) - previous), out);
+            previous = static_cast<uint64_t>(mantissa);
+        }
+        return;
+    }
+
+    out.push_back(kModeXor);
+    BitWriter writer(out);
+    uint64_t previous = std::bit_cast<uint64_t>(values[0]);
+    writer.write(previous, 64);
+    int windowLeading = -1; // Bit window of the last explicitly described XOR
+    int windowTrailing = 0;
+    for (size_t i = 1; i < values.size(); ++i) {
+        uint64_t bits = std::bit_cast<uint64_t>(values[i]);
+        uint64_t x = bits ^ previous;
+        previous = bits;
+        if (x == 0) {
+            writer.write(0b0, 1);
+            continue;
+        }
+        int leading = std::min(std::countl_zero(x), 31); // Stored in 5 bits
+        int trailing = std::countr_zero(x);
+        if (windowLeading >= 0 && leading >= windowLeading && trailing >= windowTrailing) {
+            // Meaningful bits fit in the previous window: reuse it
+            writer.write(0b10, 2);
+            writer.write(x >> windowTrailing, 64 - windowLeading - windowTrailing);
+        } else {
+            int meaningful = 64 - leading - trailing;
+            writer.write(0b11, 2);
+            writer.write(static_cast<uint64_t>(leading), 5);
+            writer.write(static_cast<uint64_t>(meaningful - 1), 6);
+            writer.write(x >> trailing, meaningful);
+            windowLeading = leading;
+            windowTrailing = trailing;
+        }
+    }
+    writer.flush();
+}
+
+bool GorillaCodec::decodeDoubles(const uint8_t* data, size_t size, size_t count, double* out) {
+    if (count == 0) {
+        return true;
+    }
+    if (size == 0) {
+        return false;
+    }
+
+    if (data[0] == kModeDecimal) {
+        if (size < 2 || data[1] > kMaxDecimals) {
+            return false;
+        }
+        double scale = kPowersOf10[data[1]];
+        const uint8_t* p = data + 2;
+        const uint8_t* end = data + size;
+        uint64_t mantissa = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t delta;
+            if (!readVarint(p, end, delta)) {
+                return false;
+            }
+            mantissa += unzigzag(delta);
+            out[i] = static_cast<double>(static_cast<int64_t>(mantissa)) / scale;
+        }
+        return true;
+    }
+
+    if (data[0] != kModeXor) {
+        return false;
+    }
+    BitReader reader(data + 1, size - 1);
+    uint64_t previous = reader.read(64);
+    out[0] = std::bit_cast<double>(previous);
+    int windowLeading = 0;
+    int windowTrailing = 0;
+    for (size_t i = 1; i < count; ++i) {
+        if (reader.readBit()) {
+            if (reader.readBit()) {
+                windowLeading = static_cast<int>(reader.read(5));
+                int meaningful = static_cast<int>(reader.read(6)) + 1;
+                if (windowLeading + meaningful > 64) {
+                    return false;
+                }
+                windowTrailing = 64 - windowLeading - meaningful;
+            }
+            int meaningful = 64 - windowLeading - windowTrailing;
+            previous ^= reader.read(meaningful) << windowTrailing;
+        }
+        out[i] = std::bit_cast<double>(previous);
+    }
+    return !reader.failed();
+}
+
+void GorillaCodec::encodeVarints(std::span<const uint64_t> values, std::vector<uint8_t>& out) {
+    for (uint64_t value : values) {
+        writeVarint(value, out);
+    }
+}
+
+bool GorillaCodec::decodeVarints(const uint8_t* data, size_t size, size_t count, uint64_t* out) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    for (size_t i = 0; i < count; ++i) {
+        if (!readVarint(p, end, out[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace fingraph
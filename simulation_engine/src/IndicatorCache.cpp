@@ -0,0 +1,41 @@
+#include "fingraph/IndicatorCache.h"
+
+namespace fingraph {
+
+IndicatorCache::IndicatorCache(size_t byte_budget)
+    : cache_(byte_budget, [](const std::string& key, const Column& column) {
+          return column->size() * sizeof(double) + key.size();
+      }) {
+}
+
+IndicatorCache::Column IndicatorCache::get(const std::string& dataset_key, const std::string& indicator_key,
+                                           size_t size, const std::function<void(std::span<double>)>& compute) {
+    return cache_.get(dataset_key + "|" + indicator_key, [&]() -> Column {
+        auto values = std::make_shared<AlignedVector<double>>(size);
+        compute(std::span<double>(values->data(), values->size()));
+        return values;
+    });
+}
+
+IndicatorCacheStats IndicatorCache::getStats() const {
+    SingleFlightLruCacheStats cached = cache_.getStats();
+    IndicatorCacheStats stats;
+    stats.hits = cached.hits;
+    stats.misses = cached.misses;
+    stats.evictions = cached.evictions;
+    stats.compute_failures = cached.failures;
+    stats.entries = cached.entries;
+    stats.bytes_in_use = cached.bytes_in_use;
+    stats.byte_budget = cached.byte_budget;
+    return stats;
+}
+
+void IndicatorCache::setByteBudget(size_t byte_budget) {
+    cache_.setByteBudget(byte_budget);
+}
+
+void IndicatorCache::clear() {
+    cache_.clear();
+}
+
+} // namespace fingraph
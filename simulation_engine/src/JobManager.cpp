@@ -1,15 +1,21 @@
 #include "fingraph/JobManager.h"
+#include "fingraph/DatabaseService.h"
 #include <sstream>
 #include <iomanip>
 #include <random>
+#include <stdexcept>
 
 namespace fingraph {
 
-JobManager::JobManager(size_t max_concurrent_jobs)
+JobManager::JobManager(size_t max_concurrent_jobs, size_t dataset_cache_bytes, size_t indicator_cache_bytes)
     : running_(false)
     , max_concurrent_jobs_(max_concurrent_jobs)
     , running_jobs_count_(0)
+    , dataset_cache_(std::make_unique<DatasetCache>(dataset_cache_bytes))
+    , indicator_cache_(std::make_unique<IndicatorCache>(indicator_cache_bytes))
+    , engine_(std::make_unique<BacktestEngine>())
     , job_counter_(0) {
+    engine_->setIndicatorCache(indicator_cache_.get());
 }
 
 JobManager::~JobManager() {
@@ -32,6 +38,45 @@ std::string JobManager::submitJob(const BacktestRequest& request) {
     return job->id;
 }
 
+std::string JobManager::submitSweep(const SweepRequest& request) {
+    ParameterGrid grid(request.axes, request.backtest.strategy_params); // Rejects a bad grid now
+    auto job = std::make_shared<Job>();
+    job->id = generateJobId();
+    job->request = request.backtest;
+    job->request.job_id = job->id;
+    job->sweep = std::make_shared<const SweepRequest>(request);
+
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex_);
+        jobs_[job->id] = job;
+    }
+
+    pushJobToQueue(job);
+
+    return job->id;
+}
+
+std::string JobManager::submitWalkForward(const WalkForwardRequest& request) {
+    ParameterGrid grid(request.sweep.axes, request.sweep.backtest.strategy_params); // Rejects a bad grid now
+    if (request.in_sample_bars == 0 || request.out_of_sample_bars == 0) {
+        throw std::invalid_argument("Walk-forward windows must not be empty");
+    }
+    auto job = std::make_shared<Job>();
+    job->id = generateJobId();
+    job->request = request.sweep.backtest;
+    job->request.job_id = job->id;
+    job->walk_forward = std::make_shared<const WalkForwardRequest>(request);
+
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex_);
+        jobs_[job->id] = job;
+    }
+
+    pushJobToQueue(job);
+
+    return job->id;
+}
+
 bool JobManager::cancelJob(const std::string& job_id) {
     std::lock_guard<std::mutex> lock(jobs_mutex_);
     auto it = jobs_.find(job_id);
@@ -45,6 +90,10 @@ bool JobManager::cancelJob(const std::string& job_id) {
         job->completed_at = std::chrono::system_clock::now();
         return true;
     }
+    if (job->status == JobStatus::RUNNING && (job->sweep || job->walk_forward)) {
+        job->cancel_requested = true; // The sweep stops after its current chunks
+        return true;
+    }
     
     return false;
 }
@@ -93,6 +142,26 @@ BacktestResults JobManager::getJobResults(const std::string& job_id) {
     return it->second->result;
 }
 
+std::shared_ptr<const SweepResult> JobManager::getSweepResults(const std::string& job_id) {
+    std::lock_guard<std::mutex> lock(jobs_mutex_);
+    auto it = jobs_.find(job_id);
+    if (it == jobs_.end() || it->second->status != JobStatus::COMPLETED) {
+        return nullptr;
+    }
+
+    return it->second->sweep_result;
+}
+
+std::shared_ptr<const WalkForwardResult> JobManager::getWalkForwardResults(const std::string& job_id) {
+    std::lock_guard<std::mutex> lock(jobs_mutex_);
+    auto it = jobs_.find(job_id);
+    if (it == jobs_.end() || it->second->status != JobStatus::COMPLETED) {
+        return nullptr;
+    }
+
+    return it->second->walk_forward_result;
+}
+
 void JobManager::setProgressCallback(ProgressCallback callback) {
     progress_callback_ = std::move(callback);
 }
@@ -167,6 +236,14 @@ void JobManager::cleanupCompletedJobs(std::chrono::hours max_age) {
     }
 }
 
+DatasetCacheStats JobManager::getDatasetCacheStats() const {
+    return dataset_cache_->getStats();
+}
+
+IndicatorCacheStats JobManager::getIndicatorCacheStats() const {
+    return indicator_cache_->getStats();
+}
+
 void JobManager::workerThread() {
     while (running_) {
         JobPtr job = popJobFromQueue();
@@ -186,7 +263,45 @@ void JobManager::executeJob(JobPtr job) {
     markJobRunning(job);
     
     try {
-        BacktestResults result = runBacktest(job->request, job);
+        if (job->walk_forward) {
+            std::shared_ptr<const WalkForwardResult> walk_forward = runWalkForward(*job->walk_forward, job);
+            if (walk_forward->cancelled) {
+                markJobCancelled(job);
+                return;
+            }
+            BacktestResults result = convertResult(job->id, walk_forward->outOfSample);
+            {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                job->walk_forward_result = std::move(walk_forward);
+            }
+            markJobCompleted(job, result);
+            return;
+        }
+        if (!job->sweep) {
+            BacktestResults result = runBacktest(job->request, job);
+            markJobCompleted(job, result);
+            return;
+        }
+        std::shared_ptr<const SweepResult> sweep = runSweep(*job->sweep, job);
+        if (sweep->cancelled) {
+            markJobCancelled(job);
+            return;
+        }
+        // The job's own results are the metrics of the best point
+        BacktestResults result{};
+        result.job_id = job->id;
+        if (!sweep->top.empty()) {
+            size_t row = sweep->top.front();
+            result.total_return = sweep->table.totalReturn[row];
+            result.sharpe_ratio = sweep->table.sharpeRatio[row];
+            result.max_drawdown = sweep->table.maxDrawdown[row];
+            result.win_rate = sweep->table.winRate[row];
+            result.total_costs = sweep->table.totalCosts[row];
+        }
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            job->sweep_result = std::move(sweep);
+        }
         markJobCompleted(job, result);
     } catch (const std::exception& e) {
         markJobFailed(job, e.what());
@@ -194,41 +309,126 @@ void JobManager::executeJob(JobPtr job) {
 }
 
 BacktestResults JobManager::runBacktest(const BacktestRequest& request, JobPtr job) {
-    BacktestResults results;
-    results.job_id = request.job_id;
-    
-    updateJobProgress(job->id, 0.1, "Initializing backtest engine");
-    
-    // Create and configure the backtest engine
-    BacktestEngine engine;
-    
     updateJobProgress(job->id, 0.2, "Loading market data");
     
-    // Run the backtest
-    BacktestResult engine_result = engine.runBacktest(
-        request.data_path,
+    std::shared_ptr<const MarketData> market_data;
+    std::string dataset_key;
+    MarketDataView data = loadData(request, market_data, dataset_key);
+    
+    // Run the backtest on the shared engine; the run gets its own strategy instance
+    BacktestResult engine_result = engine_->runBacktest(
+        data,
         request.strategy_name,
         request.strategy_params,
-        request.initial_cash
+        request.initial_cash,
+        dataset_key
     );
     
     updateJobProgress(job->id, 0.8, "Processing results");
+    BacktestResults results = convertResult(request.job_id, engine_result);
+    
+    updateJobProgress(job->id, 1.0, "Backtest completed");
+    
+    return results;
+}
+
+std::shared_ptr<const SweepResult> JobManager::runSweep(const SweepRequest& request, JobPtr job) {
+    updateJobProgress(job->id, 0.1, "Loading market data");
+
+    std::shared_ptr<const MarketData> market_data;
+    std::string dataset_key;
+    MarketDataView data = loadData(request.backtest, market_data, dataset_key);
+
+    ParameterGrid grid(request.axes, request.backtest.strategy_params);
+    updateJobProgress(job->id, 0.2, "Searching " + std::to_string(grid.size()) + " grid points");
+
+    // Every point runs over the same bars, so each indicator is computed once for all of them
+    SweepOptions options;
+    options.metric = request.metric;
+    options.topK = request.top_k;
+    options.cancelled = &job->cancel_requested;
+    options.onProgress = [this, &job](double fraction) {
+        updateJobProgress(job->id, 0.2 + 0.75 * fraction, "Searching grid points");
+    };
+    ParameterSweep sweep(*engine_);
+    const std::string& strategy = request.backtest.strategy_name;
+    double cash = request.backtest.initial_cash;
+    std::shared_ptr<const SweepResult> result;
+    switch (request.mode) {
+        case SweepMode::GRID:
+            result = std::make_shared<const SweepResult>(sweep.run(data, strategy, grid, cash, options, dataset_key));
+            break;
+        case SweepMode::SUCCESSIVE_HALVING:
+            result = std::make_shared<const SweepResult>(
+                sweep.runSuccessiveHalving(data, strategy, grid, cash, options, request.halving, dataset_key));
+            break;
+        case SweepMode::GENETIC:
+            result = std::make_shared<const SweepResult>(
+                sweep.runGenetic(data, strategy, grid, cash, options, request.genetic, dataset_key));
+            break;
+    }
+
+    if (!result->cancelled) {
+        updateJobProgress(job->id, 1.0, "Sweep completed");
+    }
+    return result;
+}
+
+std::shared_ptr<const WalkForwardResult> JobManager::runWalkForward(const WalkForwardRequest& request,
+                                                                    JobPtr job) {
+    const SweepRequest& sweep = request.sweep;
+    updateJobProgress(job->id, 0.1, "Loading market data");
+
+    std::shared_ptr<const MarketData> market_data;
+    std::string dataset_key;
+    MarketDataView data = loadData(sweep.backtest, market_data, dataset_key);
+
+    ParameterGrid grid(sweep.axes, sweep.backtest.strategy_params);
+    updateJobProgress(job->id, 0.2, "Running walk-forward folds");
+
+    WalkForwardOptions options;
+    options.inSampleBars = request.in_sample_bars;
+    options.outOfSampleBars = request.out_of_sample_bars;
+    options.anchored = request.anchored;
+    options.mode = sweep.mode;
+    options.metric = sweep.metric;
+    options.halving = sweep.halving;
+    options.genetic = sweep.genetic;
+    options.cancelled = &job->cancel_requested;
+    options.onProgress = [this, &job](double fraction) {
+        updateJobProgress(job->id, 0.2 + 0.75 * fraction, "Running walk-forward folds");
+    };
+    WalkForward walk_forward(*engine_);
+    auto result = std::make_shared<const WalkForwardResult>(walk_forward.run(
+        data, sweep.backtest.strategy_name, grid, sweep.backtest.initial_cash, options, dataset_key));
+
+    if (!result->cancelled) {
+        updateJobProgress(job->id, 1.0, "Walk-forward analysis completed");
+    }
+    return result;
+}
+
+BacktestResults JobManager::convertResult(const std::string& job_id, const BacktestResult& engine_result) {
+    BacktestResults results;
+    results.job_id = job_id;
     
     // Convert engine result to our format
     results.total_return = engine_result.totalReturn;
     results.sharpe_ratio = engine_result.sharpeRatio;
     results.max_drawdown = engine_result.maxDrawdown;
     results.win_rate = engine_result.winRate;
+    results.total_costs = engine_result.totalCosts;
     
-    // Convert trades
+    // Convert trades; symbol names are resolved only here
+    results.trades.reserve(engine_result.trades.size());
     for (const auto& trade : engine_result.trades) {
         TradeData trade_data;
-        trade_data.symbol = trade.getSymbol();
-        trade_data.type = (trade.getType() == TradeType::BUY) ? "BUY" : "SELL";
-        trade_data.quantity = trade.getQuantity();
-        trade_data.price = trade.getPrice();
+        trade_data.symbol = engine_result.symbols.getName(trade.symbol);
+        trade_data.type = toString(trade.type);
+        trade_data.quantity = trade.quantity;
+        trade_data.price = trade.price;
         trade_data.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-            trade.getTimestamp().time_since_epoch()).count();
+            trade.timestamp.time_since_epoch()).count();
         results.trades.push_back(trade_data);
     }
     
@@ -241,11 +441,61 @@ BacktestResults JobManager::runBacktest(const BacktestRequest& request, JobPtr j
         results.equity_curve.push_back(equity_point);
     }
     
-    updateJobProgress(job->id, 1.0, "Backtest completed");
-    
     return results;
 }
 
+MarketDataView JobManager::loadData(const BacktestRequest& request,
+                                    std::shared_ptr<const MarketData>& market_data,
+                                    std::string& dataset_key) {
+    dataset_key.clear(); // Left empty for database loads, which are not cached
+    if (!request.symbol.empty()) {
+        market_data = loadFromDatabase(request);
+    } else {
+        // Shared with every other job on the same file; kept alive until this job ends
+        market_data = dataset_cache_->get(request.data_path, request.bar_seconds, dataset_key);
+    }
+    
+    // Restrict to the requested window without copying the shared columns
+    MarketDataView data = market_data->getView();
+    if (request.symbol.empty() && (request.start_time != 0 || request.end_time != 0)) {
+        using std::chrono::milliseconds;
+        auto start = request.start_time != 0
+            ? std::chrono::system_clock::time_point(milliseconds(request.start_time))
+            : std::chrono::system_clock::time_point::min();
+        auto end = request.end_time != 0
+            ? std::chrono::system_clock::time_point(milliseconds(request.end_time))
+            : std::chrono::system_clock::time_point::max();
+        data = market_data->getViewInRange(start, end);
+    }
+
+    // Indicators depend on where the window starts, so it is part of the key
+    if (!dataset_key.empty() && !data.empty()) {
+        size_t offset = data.getTimestamps().data() - market_data->getTimestamps().data();
+        dataset_key += "[" + std::to_string(offset) + "+" + std::to_string(data.size()) + "]";
+    } else {
+        dataset_key.clear();
+    }
+
+    return data;
+}
+
+std::shared_ptr<const MarketData> JobManager::loadFromDatabase(const BacktestRequest& request) {
+    // The window is applied by the query; the range is inclusive, so round inwards
+    int64_t start_seconds = request.start_time != 0 ? request.start_time / 1000 + (request.start_time % 1000 > 0) : 0;
+    int64_t end_seconds = request.end_time != 0 ? request.end_time / 1000 - (request.end_time % 1000 < 0) : 0;
+
+    DatabaseService database(request.data_path);
+    auto market_data = std::make_shared<MarketData>();
+    if (!database.connect() ||
+        !database.loadMarketData(request.symbol, start_seconds, end_seconds, *market_data)) {
+        throw std::runtime_error("Failed to load " + request.symbol + " from " + request.data_path);
+    }
+    if (request.bar_seconds != 0) {
+        return std::make_shared<MarketData>(market_data->resample(request.bar_seconds));
+    }
+    return market_data;
+}
+
 void JobManager::markJobRunning(JobPtr job) {
     std::lock_guard<std::mutex> lock(jobs_mutex_);
     job->status = JobStatus::RUNNING;
@@ -263,6 +513,13 @@ void JobManager::markJobCompleted(JobPtr job, const BacktestResults& result) {
     job->current_step = "Completed";
 }
 
+void JobManager::markJobCancelled(JobPtr job) {
+    std::lock_guard<std::mutex> lock(jobs_mutex_);
+    job->status = JobStatus::CANCELLED;
+    job->completed_at = std::chrono::system_clock::now();
+    job->current_step = "Cancelled";
+}
+
 void JobManager::markJobFailed(JobPtr job, const std::string& error) {
     std::lock_guard<std::mutex> lock(jobs_mutex_);
     job->status = JobStatus::FAILED;
@@ -1,99 +1,270 @@
 #include "fingraph/MarketData.h"
-#include <fstream>
-#include <sstream>
+#include "fingraph/ColumnarCache.h"
+#include "fingraph/CsvParser.h"
+#include "fingraph/FileFingerprint.h"
+#include "fingraph/MappedFile.h"
+#include "fingraph/Resampler.h"
+#include "fingraph/ThreadPool.h"
+#include <algorithm>
 #include <iostream>
-#include <iomanip>
-#include <stdexcept>
-#include <map>
 
 namespace fingraph {
 
-bool MarketData::loadFromCSV(const std::string& filePath) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
+void LoadReport::addError(size_t line, std::string_view reason, std::string_view text) {
+    ++rowsRejected;
+    if (errors.size() < kMaxReportedErrors) {
+        constexpr size_t kMaxQuotedLength = 120;
+        std::string message(reason);
+        message += ": \"";
+        message.append(text.substr(0, kMaxQuotedLength));
+        message += '"';
+        errors.push_back({line, std::move(message)});
+    }
+}
+
+void LoadReport::merge(const LoadReport& other) {
+    rowsLoaded += other.rowsLoaded;
+    rowsRejected += other.rowsRejected;
+    for (const auto& error : other.errors) {
+        if (errors.size() >= kMaxReportedErrors) {
+            break;
+        }
+        errors.push_back(error);
+    }
+}
+
+void ColumnBuffers::reserve(size_t n) {
+    timestamps.reserve(n);
+    open.reserve(n);
+    high.reserve(n);
+    low.reserve(n);
+    close.reserve(n);
+    volume.reserve(n);
+}
+
+void ColumnBuffers::clear() {
+    timestamps.clear();
+    open.clear();
+    high.clear();
+    low.clear();
+    close.clear();
+    volume.clear();
+}
+
+void ColumnBuffers::eraseFront(size_t n) {
+    n = std::min(n, size());
+    timestamps.erase(timestamps.begin(), timestamps.begin() + n);
+    open.erase(open.begin(), open.begin() + n);
+    high.erase(high.begin(), high.begin() + n);
+    low.erase(low.begin(), low.begin() + n);
+    close.erase(close.begin(), close.begin() + n);
+    volume.erase(volume.begin(), volume.begin() + n);
+}
+
+MarketDataView::MarketDataView(const ColumnBuffers& columns)
+    : timestamps_(columns.timestamps.data())
+    , open_(columns.open.data())
+    , high_(columns.high.data())
+    , low_(columns.low.data())
+    , close_(columns.close.data())
+    , volume_(columns.volume.data())
+    , size_(columns.size()) {
+}
+
+MarketDataView MarketDataView::slice(size_t begin, size_t count) const {
+    begin = std::min(begin, size_);
+    count = std::min(count, size_ - begin);
+    return MarketDataView(timestamps_ + begin, open_ + begin, high_ + begin, low_ + begin,
+                          close_ + begin, volume_ + begin, count);
+}
+
+namespace {
+
+// First index in [first, last) whose timestamp is not "before" `target`, where
+// `before(ts, target)` is < for lower bounds and <= for upper bounds. The first
+// probe is interpolated from the end points, which lands on or next to the answer
+// for regularly spaced bars; a galloping search from there brackets it for a
+// final binary search, so irregular data still costs O(log n).
+template <typename Before>
+size_t interpolationSearch(const int64_t* timestamps, size_t size, int64_t target, Before before) {
+    if (size == 0 || !before(timestamps[0], target)) {
+        return 0;
+    }
+    if (before(timestamps[size - 1], target)) {
+        return size;
+    }
+
+    // Invariant from here on: before(ts[0]) holds and before(ts[size - 1]) does not.
+    double span = static_cast<double>(timestamps[size - 1] - timestamps[0]);
+    double fraction = span > 0 ? static_cast<double>(target - timestamps[0]) / span : 0.0;
+    size_t guess = std::min(size - 1, static_cast<size_t>(fraction * static_cast<double>(size - 1)));
+
+    size_t lo, hi; // The answer lies in (lo, hi]
+    if (before(timestamps[guess], target)) {
+        lo = guess;
+        size_t step = 1;
+        hi = std::min(size - 1, lo + step);
+        while (before(timestamps[hi], target)) {
+            lo = hi;
+            step *= 2;
+            hi = std::min(size - 1, lo + step);
+        }
+    } else {
+        hi = guess;
+        size_t step = 1;
+        lo = hi > step ? hi - step : 0;
+        while (!before(timestamps[lo], target)) {
+            hi = lo;
+            step *= 2;
+            lo = hi > step ? hi - step : 0;
+        }
+    }
+
+    const int64_t* it = std::partition_point(timestamps + lo + 1, timestamps + hi,
+                                             [&](int64_t ts) { return before(ts, target); });
+    return static_cast<size_t>(it - timestamps);
+}
+
+} // namespace
+
+size_t MarketDataView::lowerBound(int64_t epochSeconds) const {
+    return interpolationSearch(timestamps_, size_, epochSeconds,
+                               [](int64_t ts, int64_t target) { return ts < target; });
+}
+
+size_t MarketDataView::upperBound(int64_t epochSeconds) const {
+    return interpolationSearch(timestamps_, size_, epochSeconds,
+                               [](int64_t ts, int64_t target) { return ts <= target; });
+}
+
+MarketDataView MarketDataView::sliceByTime(const std::chrono::system_clock::time_point& start,
+                                           const std::chrono::system_clock::time_point& end) const {
+    // Bars carry whole seconds: round the start up and the end down
+    auto startSeconds = std::chrono::ceil<std::chrono::seconds>(start.time_since_epoch()).count();
+    auto endSeconds = std::chrono::floor<std::chrono::seconds>(end.time_since_epoch()).count();
+    size_t first = lowerBound(startSeconds);
+    size_t last = upperBound(endSeconds);
+    return slice(first, last > first ? last - first : 0);
+}
+
+bool MarketData::loadFromCSV(const std::string& filePath, const CsvLoadOptions& options) {
+    FileFingerprint fingerprint;
+    if (!FileFingerprint::compute(filePath, fingerprint)) {
         std::cerr << "Error: Could not open file " << filePath << std::endl;
         return false;
     }
 
-    data_.clear();
-    timestampIndex_.clear();
-    std::string line;
-    
-    // Skip header row
-    std::getline(file, line);
-
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string timestampStr, openStr, highStr, lowStr, closeStr, volumeStr;
-        
-        // Expected CSV format: timestamp,open,high,low,close,volume
-        std::getline(ss, timestampStr, ',');
-        std::getline(ss, openStr, ',');
-        std::getline(ss, highStr, ',');
-        std::getline(ss, lowStr, ',');
-        std::getline(ss, closeStr, ',');
-        std::getline(ss, volumeStr, ',');
-
-        try {
-            // Parse timestamp (assuming ISO 8601 format, e.g., "2023-01-01")
-            std::tm tm = {};
-            std::istringstream ss_timestamp(timestampStr);
-            ss_timestamp >> std::get_time(&tm, "%Y-%m-%d");
-            if (ss_timestamp.fail()) {
-                throw std::runtime_error("Failed to parse timestamp: " + timestampStr);
-            }
-            std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::from_time_t(std::mktime(&tm));
-
-            // Parse numeric values
-            OHLCV candle;
-            candle.timestamp = timestamp;
-            candle.open = std::stod(openStr);
-            candle.high = std::stod(highStr);
-            candle.low = std::stod(lowStr);
-            candle.close = std::stod(closeStr);
-            candle.volume = std::stoull(volumeStr);
-
-            data_.push_back(candle);
-            // Build the index for fast lookups
-            timestampIndex_[candle.timestamp] = data_.size() - 1;
-
-        } catch (const std::exception& e) {
-            std::cerr << "Error parsing line: " << line << "\n" << e.what() << std::endl;
-            // Continue to the next line instead of failing completely
+    // Warm path: map the binary columns written by an earlier parse of this exact file
+    std::string cachePath = ColumnarCache::cachePathFor(filePath);
+    if (options.useBinaryCache) {
+        std::shared_ptr<const void> storage;
+        MarketDataView view;
+        LoadReport report;
+        if (ColumnarCache::open(cachePath, fingerprint, storage, view, report)) {
+            assign(std::move(storage), view);
+            loadReport_ = report;
+            std::cout << "Successfully loaded " << size() << " data points from " << cachePath << std::endl;
+            return true;
+        }
+    }
+
+    MappedFile file;
+    if (!file.open(filePath)) {
+        std::cerr << "Error: Could not open file " << filePath << std::endl;
+        return false;
+    }
+    file.adviseSequential();
+
+    loadReport_ = LoadReport{};
+
+    // Expected CSV format: timestamp,open,high,low,close,volume (first line is a header)
+    std::string_view text = file.view();
+    std::string_view body = text.substr(CsvParser::skipHeader(text));
+    ColumnBuffers columns;
+    size_t threads = options.parseThreads != 0 ? options.parseThreads : ThreadPool::hardwareThreads();
+    if (threads > 1 && body.size() >= options.parallelMinBytes) {
+        // A few chunks per thread evens out rows of varying length; tiny chunks don't pay
+        constexpr size_t kMinChunkBytes = size_t(1) << 20;
+        size_t chunks = std::min(threads * 4, body.size() / kMinChunkBytes + 1);
+        std::unique_ptr<ThreadPool> ownPool;
+        if (options.parseThreads != 0) {
+            ownPool = std::make_unique<ThreadPool>(threads);
         }
+        ThreadPool& pool = ownPool ? *ownPool : ThreadPool::shared();
+        CsvParser::parseRowsParallel(body, 2, columns, loadReport_, pool, chunks);
+    } else {
+        columns.reserve(CsvParser::estimateRowCount(body));
+        CsvParser::parseRows(body, 2, columns, loadReport_);
+    }
+    loadReport_.rowsLoaded = columns.size();
+    assign(std::move(columns));
+
+    // One summary line instead of one message per bad row
+    if (loadReport_.rowsRejected > 0) {
+        const LoadError& first = loadReport_.errors.front();
+        std::cerr << "Warning: skipped " << loadReport_.rowsRejected << " malformed rows in " << filePath
+                  << " (first at line " << first.line << ": " << first.message << ")" << std::endl;
+    }
+
+    // Persist the columns for the next load. Skip it if the file changed while we
+    // were parsing; a read-only data directory simply means no cache.
+    FileFingerprint after;
+    if (options.useBinaryCache && FileFingerprint::compute(filePath, after) && after == fingerprint) {
+        ColumnarCache::write(cachePath, view_, fingerprint, loadReport_, options.cacheEncoding);
     }
 
-    std::cout << "Successfully loaded " << data_.size() << " data points from " << filePath << std::endl;
+    std::cout << "Successfully loaded " << size() << " data points from " << filePath << std::endl;
     return true;
 }
 
+void MarketData::assign(ColumnBuffers&& columns) {
+    auto owned = std::make_shared<const ColumnBuffers>(std::move(columns));
+    MarketDataView view(*owned);
+    assign(std::move(owned), view);
+}
+
+void MarketData::assign(std::shared_ptr<const void> storage, const MarketDataView& view) {
+    storage_ = std::move(storage);
+    view_ = view;
+    rowCache_ = std::make_shared<RowCache>();
+}
+
+MarketData MarketData::resample(int64_t barSeconds) const {
+    ColumnBuffers columns;
+    Resampler::resample(view_, barSeconds, columns);
+    MarketData result;
+    result.assign(std::move(columns));
+    return result;
+}
+
 const std::vector<OHLCV>& MarketData::getData() const {
-    return data_;
+    static const std::vector<OHLCV> kEmpty;
+    if (!rowCache_) {
+        return kEmpty;
+    }
+
+    std::call_once(rowCache_->once, [this] {
+        auto& rows = rowCache_->rows;
+        rows.reserve(view_.size());
+        for (size_t i = 0; i < view_.size(); ++i) {
+            rows.push_back(view_.getBar(i));
+        }
+    });
+    return rowCache_->rows;
 }
 
 std::vector<OHLCV> MarketData::getDataInRange(
     const std::chrono::system_clock::time_point& start,
     const std::chrono::system_clock::time_point& end) const {
     
+    // Searched directly on the timestamp column; see getViewInRange for a zero-copy result
+    MarketDataView range = getViewInRange(start, end);
     std::vector<OHLCV> result;
-    
-    // Find the starting index using the map for O(log n) complexity
-    auto startIt = timestampIndex_.lower_bound(start);
-    if (startIt == timestampIndex_.end()) {
-        return result; // Start date is after all data
-    }
-
-    size_t startIndex = startIt->second;
-    
-    // Iterate from the start index to the end of the data
-    for (size_t i = startIndex; i < data_.size(); ++i) {
-        if (data_[i].timestamp > end) {
-            break; // We've gone past the end date
-        }
-        result.push_back(data_[i]);
+    result.reserve(range.size());
+    for (size_t i = 0; i < range.size(); ++i) {
+        result.push_back(range.getBar(i));
     }
-    
     return result;
 }
 
-} // namespace fingraph
\ No newline at end of file
+} // namespace fingraph
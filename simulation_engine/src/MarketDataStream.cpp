@@ -0,0 +1,182 @@
+#include "fingraph/MarketDataStream.h"
+#include "fingraph/ColumnarCache.h"
+#include "fingraph/CsvParser.h"
+#include "fingraph/FileFingerprint.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace fingraph {
+
+namespace {
+
+// Reads CSV text a block at a time; a line cut by the block boundary is carried over.
+class CsvStream : public MarketDataStream {
+public:
+    CsvStream(std::ifstream file, size_t blockBytes)
+        : file_(std::move(file)), blockBytes_(std::max<size_t>(blockBytes, 1)) {}
+
+    size_t read(ColumnBuffers& out) override {
+        size_t before = out.size();
+        // Loop until a block yields rows, so that 0 only ever means end of data
+        while (out.size() == before && !(atEnd_ && pending_.empty())) {
+            if (!atEnd_) {
+                size_t carried = pending_.size();
+                pending_.resize(carried + blockBytes_);
+                file_.read(pending_.data() + carried, static_cast<std::streamsize>(blockBytes_));
+                size_t got = static_cast<size_t>(file_.gcount());
+                pending_.resize(carried + got);
+                atEnd_ = got < blockBytes_;
+            }
+
+            std::string_view text(pending_);
+            if (!headerSkipped_) {
+                size_t newline = text.find('\n');
+                if (newline == std::string_view::npos && !atEnd_) {
+                    continue; // Header longer than a block
+                }
+                size_t skip = CsvParser::skipHeader(text);
+                pending_.erase(0, skip);
+                text = pending_;
+                headerSkipped_ = true;
+            }
+
+            // Parse complete lines only, unless this is the end of the file
+            size_t cut = text.size();
+            if (!atEnd_) {
+                size_t lastNewline = text.rfind('\n');
+                cut = lastNewline == std::string_view::npos ? 0 : lastNewline + 1;
+            }
+            out.reserve(out.size() + CsvParser::estimateRowCount(text.substr(0, cut)));
+            nextLine_ += CsvParser::parseRows(text.substr(0, cut), nextLine_, out, report_);
+            pending_.erase(0, cut);
+        }
+        report_.rowsLoaded += out.size() - before;
+        return out.size() - before;
+    }
+
+private:
+    std::ifstream file_;
+    size_t blockBytes_;
+    std::string pending_;    // Unparsed text: at most one partial line between reads
+    size_t nextLine_ = 2;    // 1-based line number of the start of pending_
+    bool headerSkipped_ = false;
+    bool atEnd_ = false;
+};
+
+// Reads rows from the columns of a .fgc cache a block at a time. Compressed
+// caches are read one encoded block per column at a time.
+class ColumnarCacheStream : public MarketDataStream {
+public:
+    ColumnarCacheStream(std::ifstream file, const ColumnarCacheHeader& header, size_t blockBytes)
+        : file_(std::move(file)), header_(header),
+          compressed_(header.encoding == static_cast<uint32_t>(CacheEncoding::Gorilla)) {
+        constexpr size_t kBytesPerRow = sizeof(int64_t) + 4 * sizeof(double) + sizeof(uint64_t);
+        blockRows_ = compressed_ ? header.blockRows : std::max<size_t>(blockBytes / kBytesPerRow, 1);
+        report_.rowsRejected = static_cast<size_t>(header.rowsRejected);
+    }
+
+    size_t read(ColumnBuffers& out) override {
+        size_t rows = std::min<uint64_t>(blockRows_, header_.rowCount - nextRow_);
+        if (rows == 0) {
+            return 0;
+        }
+        size_t at = out.size();
+        bool ok = true;
+        if (compressed_) {
+            out.timestamps.resize(at + rows);
+            out.open.resize(at + rows);
+            out.high.resize(at + rows);
+            out.low.resize(at + rows);
+            out.close.resize(at + rows);
+            out.volume.resize(at + rows);
+            for (uint32_t c = 0; c < ColumnarCacheHeader::kColumnCount && ok; ++c) {
+                ok = readCompressedBlock(c, out, at, rows);
+            }
+        } else {
+            readColumn(0, out.timestamps, at, rows);
+            readColumn(1, out.open, at, rows);
+            readColumn(2, out.high, at, rows);
+            readColumn(3, out.low, at, rows);
+            readColumn(4, out.close, at, rows);
+            readColumn(5, out.volume, at, rows);
+            ok = static_cast<bool>(file_);
+        }
+        if (!ok) {
+            // Truncated or corrupted underneath us: drop the partial block and stop
+            out.timestamps.resize(at);
+            out.open.resize(at);
+            out.high.resize(at);
+            out.low.resize(at);
+            out.close.resize(at);
+            out.volume.resize(at);
+            nextRow_ = header_.rowCount;
+            return 0;
+        }
+        nextRow_ += rows;
+        report_.rowsLoaded += rows;
+        return rows;
+    }
+
+private:
+    template <typename T>
+    void readColumn(int column, AlignedVector<T>& values, size_t at, size_t rows) {
+        values.resize(at + rows);
+        file_.seekg(static_cast<std::streamoff>(header_.columnOffsets[column] + nextRow_ * sizeof(T)));
+        file_.read(reinterpret_cast<char*>(values.data() + at), static_cast<std::streamsize>(rows * sizeof(T)));
+    }
+
+    bool readCompressedBlock(uint32_t column, ColumnBuffers& out, size_t at, size_t rows) {
+        uint64_t block = nextRow_ / blockRows_;
+        uint64_t range[2];
+        file_.seekg(static_cast<std::streamoff>(header_.columnOffsets[column] + block * sizeof(uint64_t)));
+        if (!file_.read(reinterpret_cast<char*>(range), sizeof(range)) ||
+            range[0] > range[1] || range[1] > header_.columnBytes[column]) {
+            return false;
+        }
+        scratch_.resize(static_cast<size_t>(range[1] - range[0]));
+        file_.seekg(static_cast<std::streamoff>(header_.columnOffsets[column] + range[0]));
+        if (!file_.read(reinterpret_cast<char*>(scratch_.data()), static_cast<std::streamsize>(scratch_.size()))) {
+            return false;
+        }
+        return ColumnarCache::decodeBlock(column, scratch_.data(), scratch_.size(), rows, out, at);
+    }
+
+    std::ifstream file_;
+    ColumnarCacheHeader header_;
+    bool compressed_;
+    size_t blockRows_;
+    std::vector<uint8_t> scratch_; // One encoded block
+    uint64_t nextRow_ = 0;
+};
+
+} // namespace
+
+std::unique_ptr<MarketDataStream> MarketDataStream::open(const std::string& filePath,
+                                                         const MarketDataStreamOptions& options) {
+    FileFingerprint fingerprint;
+    if (!FileFingerprint::compute(filePath, fingerprint)) {
+        return nullptr;
+    }
+
+    if (options.useBinaryCache) {
+        std::string cachePath = ColumnarCache::cachePathFor(filePath);
+        std::ifstream cache(cachePath, std::ios::binary);
+        ColumnarCacheHeader header;
+        std::error_code ec;
+        uint64_t cacheSize = std::filesystem::file_size(cachePath, ec);
+        if (cache.is_open() && !ec &&
+            cache.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+            ColumnarCache::validateHeader(header, cacheSize, fingerprint)) {
+            return std::make_unique<ColumnarCacheStream>(std::move(cache), header, options.blockBytes);
+        }
+    }
+
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return nullptr;
+    }
+    return std::make_unique<CsvStream>(std::move(file), options.blockBytes);
+}
+
+} // namespace fingraph
@@ -0,0 +1,158 @@
+#include "fingraph/MarketPanel.h"
+#include "fingraph/ThreadPool.h"
+#include <cmath>
+#include <functional>
+#include <future>
+#include <queue>
+#include <stdexcept>
+
+namespace fingraph {
+
+bool MarketPanel::loadFromCSV(const std::vector<std::string>& symbols, const std::vector<std::string>& filePaths,
+                              const CsvLoadOptions& options) {
+    if (symbols.size() != filePaths.size()) {
+        throw std::invalid_argument("MarketPanel needs exactly one file per symbol");
+    }
+
+    // One file per task. Each file is parsed serially: the pool's threads are
+    // already busy with the other files, and a task must not wait on the pool.
+    CsvLoadOptions perFile = options;
+    perFile.parseThreads = 1;
+    std::vector<std::future<std::shared_ptr<const MarketData>>> pending;
+    pending.reserve(filePaths.size());
+    for (const auto& path : filePaths) {
+        pending.push_back(ThreadPool::shared().submit([&path, &perFile]() -> std::shared_ptr<const MarketData> {
+            auto data = std::make_shared<MarketData>();
+            if (!data->loadFromCSV(path, perFile)) {
+                return nullptr;
+            }
+            return data;
+        }));
+    }
+
+    // The tasks reference `perFile`: let them all finish before anything can throw
+    for (auto& f : pending) {
+        f.wait();
+    }
+    std::vector<std::shared_ptr<const MarketData>> series;
+    series.reserve(pending.size());
+    bool ok = true;
+    for (auto& f : pending) {
+        series.push_back(f.get());
+        ok = ok && series.back() != nullptr;
+    }
+    if (!ok) {
+        return false;
+    }
+    assign(symbols, std::move(series));
+    return true;
+}
+
+void MarketPanel::assign(std::vector<std::string> symbols, std::vector<std::shared_ptr<const MarketData>> series) {
+    if (symbols.size() != series.size()) {
+        throw std::invalid_argument("MarketPanel needs exactly one series per symbol");
+    }
+    for (const auto& s : series) {
+        if (!s || s->size() >= kNoBar) {
+            throw std::invalid_argument("MarketPanel series must be loaded and shorter than 2^32 bars");
+        }
+    }
+    symbols_ = std::move(symbols);
+    series_ = std::move(series);
+
+    // Union of the (ascending) timestamp columns: k-way merge, duplicates collapsed
+    timestamps_.clear();
+    using Cursor = std::pair<int64_t, size_t>; // (timestamp, symbol)
+    std::priority_queue<Cursor, std::vector<Cursor>, std::greater<>> heads;
+    std::vector<size_t> positions(series_.size(), 0);
+    for (size_t s = 0; s < series_.size(); ++s) {
+        if (!series_[s]->empty()) {
+            heads.emplace(series_[s]->getTimestamps()[0], s);
+        }
+    }
+    while (!heads.empty()) {
+        auto [ts, s] = heads.top();
+        heads.pop();
+        if (timestamps_.empty() || timestamps_.back() != ts) {
+            timestamps_.push_back(ts);
+        }
+        auto column = series_[s]->getTimestamps();
+        if (++positions[s] < column.size()) {
+            heads.emplace(column[positions[s]], s);
+        }
+    }
+
+    // Per symbol: the latest bar at or before each axis position, and whether it is exact
+    size_t length = timestamps_.size();
+    present_.assign(series_.size() * length, 0);
+    fillIndex_.assign(series_.size() * length, kNoBar);
+    for (size_t s = 0; s < series_.size(); ++s) {
+        auto column = series_[s]->getTimestamps();
+        uint8_t* present = present_.data() + s * length;
+        uint32_t* fill = fillIndex_.data() + s * length;
+        size_t next = 0;
+        uint32_t current = kNoBar;
+        for (size_t t = 0; t < length; ++t) {
+            while (next < column.size() && column[next] <= timestamps_[t]) {
+                present[t] = column[next] == timestamps_[t];
+                current = static_cast<uint32_t>(next++);
+            }
+            fill[t] = current;
+        }
+    }
+
+    for (auto& matrix : prices_) {
+        matrix = std::make_shared<LazyMatrix<double>>();
+    }
+    volumes_ = std::make_shared<LazyMatrix<uint64_t>>();
+}
+
+size_t MarketPanel::findSymbol(const std::string& symbol) const {
+    for (size_t s = 0; s < symbols_.size(); ++s) {
+        if (symbols_[s] == symbol) {
+            return s;
+        }
+    }
+    return npos;
+}
+
+const AlignedVector<double>& MarketPanel::field(PriceField which) const {
+    LazyMatrix<double>& matrix = *prices_[which];
+    std::call_once(matrix.once, [&] {
+        size_t length = size();
+        matrix.values.resize(series_.size() * length);
+        for (size_t s = 0; s < series_.size(); ++s) {
+            const MarketDataView& view = series_[s]->getView();
+            std::span<const double> source = which == kOpen ? view.getOpens()
+                                           : which == kHigh ? view.getHighs()
+                                           : which == kLow  ? view.getLows()
+                                                            : view.getCloses();
+            const uint32_t* fill = fillIndex_.data() + s * length;
+            double* out = matrix.values.data() + s * length;
+            for (size_t t = 0; t < length; ++t) {
+                out[t] = fill[t] == kNoBar ? std::nan("") : source[fill[t]];
+            }
+        }
+    });
+    return matrix.values;
+}
+
+std::span<const uint64_t> MarketPanel::getVolumes(size_t symbol) const {
+    LazyMatrix<uint64_t>& matrix = *volumes_;
+    std::call_once(matrix.once, [&] {
+        size_t length = size();
+        matrix.values.resize(series_.size() * length);
+        for (size_t s = 0; s < series_.size(); ++s) {
+            auto source = series_[s]->getVolumes();
+            const uint32_t* fill = fillIndex_.data() + s * length;
+            const uint8_t* present = present_.data() + s * length;
+            uint64_t* out = matrix.values.data() + s * length;
+            for (size_t t = 0; t < length; ++t) {
+                out[t] = present[t] ? source[fill[t]] : 0; // No trading where there is no bar
+            }
+        }
+    });
+    return row(matrix.values, symbol);
+}
+
+} // namespace fingraph
@@ -0,0 +1,245 @@
+#include "fingraph/OrderBook.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace fingraph {
+
+namespace {
+
+bool isPositive(double value) {
+    return std::isfinite(value) && value > 0;
+}
+
+// Heap orders: the highest trigger price first, and the lowest trail first; ties
+// go to the older order.
+constexpr auto triggersLater = [](const auto& a, const auto& b) {
+    return a.key < b.key || (a.key == b.key && a.id > b.id);
+};
+constexpr auto trailsWider = [](const auto& a, const auto& b) {
+    return a.key > b.key || (a.key == b.key && a.id > b.id);
+};
+constexpr auto stopsLower = [](const auto& a, const auto& b) {
+    return a.stop < b.stop;
+};
+
+} // namespace
+
+OrderId OrderBook::place(const Order& order) {
+    if (!isPositive(order.quantity)) {
+        throw std::invalid_argument("Order quantity must be positive");
+    }
+    if (order.type != OrderType::MARKET && !isPositive(order.price)) {
+        throw std::invalid_argument("Order price must be positive");
+    }
+    if (order.type == OrderType::TRAILING_STOP && !isPositive(order.trail)) {
+        throw std::invalid_argument("Trailing stop needs a positive trail");
+    }
+
+    OrderId id = nextId_++;
+    SymbolBook& book = getBook(order.symbol);
+    resting_.emplace(id, order);
+    ++book.resting;
+    if (order.type == OrderType::MARKET) {
+        book.market.push_back(id);
+        return id;
+    }
+
+    bool mirrored = false;
+    Side& side = getSide(book, order, mirrored);
+    double price = mirrored ? -order.price : order.price;
+    if (order.type == OrderType::TRAILING_STOP) {
+        auto bucket = side.trailing.try_emplace(price).first;
+        bucket->second.byTrail.push_back({order.trail, id});
+        std::push_heap(bucket->second.byTrail.begin(), bucket->second.byTrail.end(), trailsWider);
+        refreshBucket(side, bucket);
+    } else {
+        side.fixed.push_back({price, id});
+        std::push_heap(side.fixed.begin(), side.fixed.end(), triggersLater);
+    }
+    return id;
+}
+
+bool OrderBook::cancel(OrderId id) {
+    auto it = resting_.find(id);
+    if (it == resting_.end()) {
+        return false;
+    }
+    SymbolBook& book = books_[it->second.symbol];
+    if (it->second.type != OrderType::MARKET) {
+        bool mirrored = false;
+        ++getSide(book, it->second, mirrored).cancelled; // Its heap entry goes when popped or compacted
+    }
+    resting_.erase(it);
+    --book.resting;
+    compact(book);
+    return true;
+}
+
+const Order* OrderBook::find(OrderId id) const {
+    auto it = resting_.find(id);
+    return it != resting_.end() ? &it->second : nullptr;
+}
+
+void OrderBook::processBar(SymbolId symbol, double open, double high, double low, std::vector<Fill>& fills) {
+    if (!hasOrders(symbol) || std::isnan(open) || std::isnan(high) || std::isnan(low)) {
+        return;
+    }
+    SymbolBook& book = books_[symbol];
+    for (OrderId id : book.market) {
+        if (isResting(id)) {
+            fill(id, open, fills);
+        }
+    }
+    book.market.clear();
+
+    fillSide(book.low, open, low, 1.0, fills);
+    fillSide(book.high, -open, -high, -1.0, fills);
+    ratchet(book.low, high);
+    ratchet(book.high, -low);
+    compact(book);
+}
+
+OrderBook::SymbolBook& OrderBook::getBook(SymbolId symbol) {
+    if (symbol >= books_.size()) {
+        books_.resize(symbol + 1);
+    }
+    return books_[symbol];
+}
+
+OrderBook::Side& OrderBook::getSide(SymbolBook& book, const Order& order, bool& mirrored) {
+    // A buy limit, a sell stop and a sell trailing stop are all waiting for the price to fall
+    bool buy = order.side == TradeType::BUY;
+    mirrored = order.type == OrderType::LIMIT ? !buy : buy;
+    return mirrored ? book.high : book.low;
+}
+
+void OrderBook::fillSide(Side& side, double open, double x, double sign, std::vector<Fill>& fills) {
+    while (!side.fixed.empty() && side.fixed.front().key >= x) {
+        Entry top = side.fixed.front();
+        std::pop_heap(side.fixed.begin(), side.fixed.end(), triggersLater);
+        side.fixed.pop_back();
+        if (isResting(top.id)) {
+            fill(top.id, sign * std::min(open, top.key), fills); // The open if the bar gapped through
+        } else {
+            --side.cancelled;
+        }
+    }
+
+    while (!side.bucketStops.empty() && side.bucketStops.front().stop >= x) {
+        BucketStop top = side.bucketStops.front();
+        std::pop_heap(side.bucketStops.begin(), side.bucketStops.end(), stopsLower);
+        side.bucketStops.pop_back();
+        auto bucket = side.trailing.find(top.extreme);
+        if (bucket == side.trailing.end() || bucket->second.version != top.version) {
+            continue; // Superseded
+        }
+        std::vector<Entry>& byTrail = bucket->second.byTrail;
+        while (!byTrail.empty()) {
+            Entry entry = byTrail.front();
+            bool resting = isResting(entry.id);
+            double stop = top.extreme - entry.key;
+            if (resting && stop < x) {
+                break;
+            }
+            std::pop_heap(byTrail.begin(), byTrail.end(), trailsWider);
+            byTrail.pop_back();
+            if (resting) {
+                fill(entry.id, sign * std::min(open, stop), fills);
+            } else {
+                --side.cancelled;
+            }
+        }
+        refreshBucket(side, bucket);
+    }
+}
+
+void OrderBook::fill(OrderId id, double price, std::vector<Fill>& fills) {
+    auto it = resting_.find(id);
+    const Order& order = it->second;
+    fills.push_back({id, order.symbol, order.side, order.quantity, price, order.type, order.price});
+    --books_[order.symbol].resting;
+    resting_.erase(it);
+}
+
+void OrderBook::ratchet(Side& side, double extreme) {
+    auto end = side.trailing.lower_bound(extreme);
+    if (end == side.trailing.begin()) {
+        return;
+    }
+    // Every bucket below the new extreme now shares it; merge the smaller heaps into the larger
+    std::vector<Entry> merged;
+    if (end != side.trailing.end() && end->first == extreme) {
+        merged = std::move(end->second.byTrail);
+    }
+    for (auto bucket = side.trailing.begin(); bucket != end; ++bucket) {
+        std::vector<Entry>& byTrail = bucket->second.byTrail;
+        if (merged.size() < byTrail.size()) {
+            merged.swap(byTrail);
+        }
+        for (const Entry& entry : byTrail) {
+            merged.push_back(entry);
+            std::push_heap(merged.begin(), merged.end(), trailsWider);
+        }
+    }
+    side.trailing.erase(side.trailing.begin(), end);
+    auto bucket = side.trailing.try_emplace(extreme).first;
+    bucket->second.byTrail = std::move(merged);
+    refreshBucket(side, bucket);
+}
+
+void OrderBook::refreshBucket(Side& side, BucketMap::iterator bucket) {
+    std::vector<Entry>& byTrail = bucket->second.byTrail;
+    while (!byTrail.empty() && !isResting(byTrail.front().id)) {
+        std::pop_heap(byTrail.begin(), byTrail.end(), trailsWider);
+        byTrail.pop_back();
+        --side.cancelled;
+    }
+    if (byTrail.empty()) {
+        side.trailing.erase(bucket);
+        return;
+    }
+    // Older entries for this bucket become stale and are skipped when popped
+    bucket->second.version = ++side.versions;
+    side.bucketStops.push_back({bucket->first - byTrail.front().key, bucket->first, bucket->second.version});
+    std::push_heap(side.bucketStops.begin(), side.bucketStops.end(), stopsLower);
+
+    if (side.bucketStops.size() > 2 * side.trailing.size() + kCompactThreshold) {
+        side.bucketStops.clear();
+        for (const auto& [extreme, other] : side.trailing) {
+            side.bucketStops.push_back({extreme - other.byTrail.front().key, extreme, other.version});
+        }
+        std::make_heap(side.bucketStops.begin(), side.bucketStops.end(), stopsLower);
+    }
+}
+
+void OrderBook::compact(SymbolBook& book) {
+    size_t cancelled = book.low.cancelled + book.high.cancelled;
+    if (cancelled > kCompactThreshold && cancelled > book.resting) {
+        compact(book.low);
+        compact(book.high);
+    }
+}
+
+void OrderBook::compact(Side& side) {
+    auto cancelled = [this](const Entry& entry) { return !isResting(entry.id); };
+    std::erase_if(side.fixed, cancelled);
+    std::make_heap(side.fixed.begin(), side.fixed.end(), triggersLater);
+
+    side.bucketStops.clear();
+    for (auto bucket = side.trailing.begin(); bucket != side.trailing.end();) {
+        std::vector<Entry>& byTrail = bucket->second.byTrail;
+        std::erase_if(byTrail, cancelled);
+        if (byTrail.empty()) {
+            bucket = side.trailing.erase(bucket);
+            continue;
+        }
+        std::make_heap(byTrail.begin(), byTrail.end(), trailsWider);
+        side.bucketStops.push_back({bucket->first - byTrail.front().key, bucket->first, bucket->second.version});
+        ++bucket;
+    }
+    std::make_heap(side.bucketStops.begin(), side.bucketStops.end(), stopsLower);
+    side.cancelled = 0;
+}
+
+} // namespace fingraph
@@ -0,0 +1,532 @@
+#include "fingraph/ParameterSweep.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace fingraph {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+struct Ranked {
+    double score;
+    size_t row;
+};
+
+// Heap order with the worst point on top, so the heap keeps the best K.
+constexpr auto ranksHigher = [](const Ranked& a, const Ranked& b) {
+    return a.score > b.score || (a.score == b.score && a.row < b.row);
+};
+
+// Higher is better for every metric once drawdowns are negated; NaN ranks last.
+double scoreOf(SweepMetric metric, double value) {
+    if (std::isnan(value)) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    return metric == SweepMetric::MAX_DRAWDOWN ? -value : value;
+}
+
+// `count` distinct points of a grid of `size`, in order; all of them for 0 (Floyd's sampling).
+std::vector<size_t> samplePoints(size_t size, size_t count, uint64_t seed) {
+    std::vector<size_t> points;
+    if (count == 0 || count >= size) {
+        points.resize(size);
+        std::iota(points.begin(), points.end(), size_t(0));
+        return points;
+    }
+    std::mt19937_64 rng(seed);
+    std::unordered_set<size_t> chosen;
+    for (size_t j = size - count; j < size; ++j) {
+        size_t t = std::uniform_int_distribution<size_t>(0, j)(rng);
+        chosen.insert(chosen.count(t) ? j : t);
+    }
+    points.assign(chosen.begin(), chosen.end());
+    std::sort(points.begin(), points.end());
+    return points;
+}
+
+void appendRows(SweepTable& table, const SweepTable& rows) {
+    table.totalReturn.insert(table.totalReturn.end(), rows.totalReturn.begin(), rows.totalReturn.end());
+    table.sharpeRatio.insert(table.sharpeRatio.end(), rows.sharpeRatio.begin(), rows.sharpeRatio.end());
+    table.maxDrawdown.insert(table.maxDrawdown.end(), rows.maxDrawdown.begin(), rows.maxDrawdown.end());
+    table.winRate.insert(table.winRate.end(), rows.winRate.begin(), rows.winRate.end());
+    table.totalCosts.insert(table.totalCosts.end(), rows.totalCosts.begin(), rows.totalCosts.end());
+    table.tradeCount.insert(table.tradeCount.end(), rows.tradeCount.begin(), rows.tradeCount.end());
+}
+
+// What one worker hands back once the counter runs out.
+struct WorkerResult {
+    std::vector<Ranked> best;
+    size_t bars = 0;
+    size_t failed = 0;
+    size_t firstFailedRow = std::numeric_limits<size_t>::max();
+    std::string firstError;
+};
+
+} // namespace
+
+ParameterAxis ParameterAxis::range(std::string name, double start, double stop, double step) {
+    if (!(step > 0) || !(stop >= start) || !std::isfinite(stop - start)) {
+        throw std::invalid_argument("Parameter range for " + name + " needs start <= stop and a positive step");
+    }
+    // Tolerate stop landing a rounding error short of the last step
+    size_t count = static_cast<size_t>(std::floor((stop - start) / step + 1e-9)) + 1;
+    ParameterAxis axis{std::move(name), {}};
+    axis.values.reserve(count);
+    for (size_t k = 0; k < count; ++k) {
+        axis.values.push_back(start + static_cast<double>(k) * step);
+    }
+    return axis;
+}
+
+ParameterGrid::ParameterGrid(std::vector<ParameterAxis> axes, std::map<std::string, double> fixed)
+    : axes_(std::move(axes)), fixed_(std::move(fixed)), strides_(axes_.size()) {
+    std::set<std::string> names;
+    for (size_t axis = axes_.size(); axis-- > 0;) {
+        const ParameterAxis& current = axes_[axis];
+        if (current.values.empty()) {
+            throw std::invalid_argument("Parameter axis has no values: " + current.name);
+        }
+        if (!names.insert(current.name).second) {
+            throw std::invalid_argument("Parameter swept twice: " + current.name);
+        }
+        strides_[axis] = size_;
+        if (size_ > std::numeric_limits<size_t>::max() / current.values.size()) {
+            throw std::invalid_argument("Parameter grid has too many points");
+        }
+        size_ *= current.values.size();
+    }
+}
+
+size_t ParameterGrid::getIndex(const std::vector<size_t>& axisIndices) const {
+    size_t index = 0;
+    for (size_t axis = 0; axis < axes_.size(); ++axis) {
+        index += axisIndices[axis] * strides_[axis];
+    }
+    return index;
+}
+
+void ParameterGrid::getPoint(size_t index, std::map<std::string, double>& params) const {
+    params = fixed_;
+    for (size_t axis = 0; axis < axes_.size(); ++axis) {
+        params[axes_[axis].name] = getValue(index, axis);
+    }
+}
+
+SweepMetric sweepMetricFromString(const std::string& name) {
+    if (name == "total_return") return SweepMetric::TOTAL_RETURN;
+    if (name == "sharpe_ratio") return SweepMetric::SHARPE_RATIO;
+    if (name == "max_drawdown") return SweepMetric::MAX_DRAWDOWN;
+    if (name == "win_rate") return SweepMetric::WIN_RATE;
+    throw std::invalid_argument("Unknown sweep metric: " + name);
+}
+
+SweepMode sweepModeFromString(const std::string& name) {
+    if (name == "grid") return SweepMode::GRID;
+    if (name == "successive_halving") return SweepMode::SUCCESSIVE_HALVING;
+    if (name == "genetic") return SweepMode::GENETIC;
+    throw std::invalid_argument("Unknown sweep mode: " + name);
+}
+
+void SweepTable::resize(size_t rows) {
+    totalReturn.resize(rows, kNaN);
+    sharpeRatio.resize(rows, kNaN);
+    maxDrawdown.resize(rows, kNaN);
+    winRate.resize(rows, kNaN);
+    totalCosts.resize(rows, kNaN);
+    tradeCount.resize(rows, 0);
+}
+
+const std::vector<double>& SweepTable::getColumn(SweepMetric metric) const {
+    switch (metric) {
+        case SweepMetric::TOTAL_RETURN: return totalReturn;
+        case SweepMetric::SHARPE_RATIO: return sharpeRatio;
+        case SweepMetric::MAX_DRAWDOWN: return maxDrawdown;
+        case SweepMetric::WIN_RATE: return winRate;
+    }
+    throw std::invalid_argument("Unknown sweep metric");
+}
+
+ParameterSweep::ParameterSweep(BacktestEngine& engine, ThreadPool& pool)
+    : engine_(engine), pool_(pool) {}
+
+SweepResult ParameterSweep::run(const MarketDataView& data,
+                                const std::string& strategyName,
+                                const ParameterGrid& grid,
+                                double initialCash,
+                                const SweepOptions& options,
+                                const std::string& datasetKey) {
+    return evaluate(data, strategyName, grid, nullptr, nullptr, initialCash, options, datasetKey);
+}
+
+SweepResult ParameterSweep::run(const MarketDataView& data,
+                                const std::string& strategyName,
+                                const ParameterGrid& grid,
+                                std::vector<size_t> rows,
+                                double initialCash,
+                                const SweepOptions& options,
+                                const std::string& datasetKey) {
+    for (size_t row : rows) {
+        if (row >= grid.size()) {
+            throw std::invalid_argument("Grid point out of range: " + std::to_string(row));
+        }
+    }
+    return evaluate(data, strategyName, grid, &rows, nullptr, initialCash, options, datasetKey);
+}
+
+SweepResult ParameterSweep::evaluate(const MarketDataView& data, const std::string& strategyName,
+                                     const ParameterGrid& grid, const std::vector<size_t>* rows,
+                                     const std::vector<size_t>* lengths, double initialCash,
+                                     const SweepOptions& options,
+                                     const std::string& datasetKey) {
+    SweepResult result;
+    result.grid = grid;
+    size_t points = rows ? rows->size() : grid.size();
+    result.table.resize(points);
+    if (rows) {
+        result.rows = *rows;
+    }
+    if (points == 0) {
+        return result;
+    }
+
+    SweepTable& table = result.table;
+    const std::vector<double>& ranked = table.getColumn(options.metric);
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    // Small enough that every thread gets several chunks
+    size_t chunkSize = std::clamp<size_t>(points / (4 * pool_.size()), 1, kChunkSize);
+
+    // Rows are disjoint between workers, so they write the table without locking
+    auto work = [&]() {
+        WorkerResult local;
+        std::map<std::string, double> params;
+        std::string prefixKey;
+        while (options.cancelled == nullptr || !options.cancelled->load(std::memory_order_relaxed)) {
+            size_t begin = next.fetch_add(chunkSize, std::memory_order_relaxed);
+            if (begin >= points) {
+                break;
+            }
+            size_t end = std::min(begin + chunkSize, points);
+            for (size_t row = begin; row < end; ++row) {
+                grid.getPoint(rows ? (*rows)[row] : row, params);
+                MarketDataView view = data;
+                const std::string* key = &datasetKey;
+                if (lengths && (*lengths)[row] < data.size()) {
+                    view = data.slice(0, (*lengths)[row]);
+                    if (!datasetKey.empty()) {
+                        prefixKey = datasetKey + "[0+" + std::to_string(view.size()) + "]"; // Indicators of its own
+                        key = &prefixKey;
+                    }
+                }
+                local.bars += view.size();
+                try {
+                    BacktestResult run = engine_.runBacktest(view, strategyName, params, initialCash, *key);
+                    table.totalReturn[row] = run.totalReturn;
+                    table.sharpeRatio[row] = run.sharpeRatio;
+                    table.maxDrawdown[row] = run.maxDrawdown;
+                    table.winRate[row] = run.winRate;
+                    table.totalCosts[row] = run.totalCosts;
+                    table.tradeCount[row] = static_cast<uint32_t>(run.trades.size());
+                } catch (const std::exception& e) {
+                    ++local.failed;
+                    if (row < local.firstFailedRow) {
+                        local.firstFailedRow = row;
+                        local.firstError = e.what();
+                    }
+                    continue;
+                }
+
+                if (options.topK == 0 || std::isnan(ranked[row])) {
+                    continue;
+                }
+                Ranked candidate{scoreOf(options.metric, ranked[row]), row};
+                if (local.best.size() < options.topK) {
+                    local.best.push_back(candidate);
+                    std::push_heap(local.best.begin(), local.best.end(), ranksHigher);
+                } else if (ranksHigher(candidate, local.best.front())) {
+                    std::pop_heap(local.best.begin(), local.best.end(), ranksHigher);
+                    local.best.back() = candidate;
+                    std::push_heap(local.best.begin(), local.best.end(), ranksHigher);
+                }
+            }
+            done.fetch_add(end - begin, std::memory_order_relaxed);
+        }
+        return local;
+    };
+
+    size_t chunks = (points + chunkSize - 1) / chunkSize;
+    size_t workers = std::max<size_t>(1, std::min(pool_.size(), chunks));
+    std::vector<std::future<WorkerResult>> futures;
+    futures.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        futures.push_back(pool_.submit(work));
+    }
+
+    // Every worker must finish before unwinding: they all reference this frame
+    std::vector<Ranked> best;
+    std::exception_ptr error;
+    size_t firstFailedRow = std::numeric_limits<size_t>::max();
+    for (auto& future : futures) {
+        if (options.onProgress) {
+            while (future.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready) {
+                options.onProgress(static_cast<double>(done.load(std::memory_order_relaxed)) / points);
+            }
+        }
+        try {
+            WorkerResult local = future.get();
+            best.insert(best.end(), local.best.begin(), local.best.end());
+            result.barsExecuted += local.bars;
+            result.failed += local.failed;
+            if (local.firstFailedRow < firstFailedRow) {
+                firstFailedRow = local.firstFailedRow;
+                result.firstError = std::move(local.firstError);
+            }
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    result.evaluated = done.load();
+    result.cancelled = result.evaluated < points;
+    std::sort(best.begin(), best.end(), ranksHigher);
+    best.resize(std::min(best.size(), options.topK));
+    result.top.reserve(best.size());
+    for (const Ranked& entry : best) {
+        result.top.push_back(entry.row);
+    }
+    if (options.onProgress) {
+        options.onProgress(static_cast<double>(result.evaluated) / points);
+    }
+    return result;
+}
+
+SweepResult ParameterSweep::runSuccessiveHalving(const MarketDataView& data,
+                                                 const std::string& strategyName,
+                                                 const ParameterGrid& grid,
+                                                 double initialCash,
+                                                 const SweepOptions& options,
+                                                 const SuccessiveHalvingOptions& halving,
+                                                 const std::string& datasetKey) {
+    if (halving.rungs == 0 || !(halving.eta > 1)) {
+        throw std::invalid_argument("Successive halving needs at least one rung and an eta above 1");
+    }
+    std::vector<size_t> candidates = samplePoints(grid.size(), halving.candidates, halving.seed);
+    SweepOptions rungOptions;
+    rungOptions.metric = options.metric;
+    rungOptions.cancelled = options.cancelled;
+
+    // Warm-up bars of each candidate, which every rung adds to its prefix
+    std::unordered_map<size_t, size_t> lookbacks;
+    std::map<std::string, double> params;
+    auto getLookback = [&](size_t point) {
+        auto [it, added] = lookbacks.try_emplace(point, 0);
+        if (added) {
+            grid.getPoint(point, params);
+            size_t lookback = engine_.getMaxLookback(strategyName, params);
+            it->second = lookback == Strategy::kUnboundedLookback ? 0 : lookback;
+        }
+        return it->second;
+    };
+
+    SweepResult result;
+    size_t evaluated = 0;
+    size_t barsExecuted = 0;
+    std::vector<size_t> lengths;
+    for (size_t rung = 0; rung < halving.rungs; ++rung) {
+        // A lone candidate goes straight to the full history
+        bool last = rung + 1 == halving.rungs || candidates.size() <= 1;
+        double shrink = std::pow(halving.eta, static_cast<double>(halving.rungs - 1 - rung));
+        size_t budget = std::max<size_t>(1, std::llround(data.size() / shrink));
+        // Rounded up to a quarter of the budget, so that candidates share prefixes and their indicators
+        size_t granularity = std::max<size_t>(1, budget / 4);
+        lengths.clear();
+        for (size_t point : candidates) {
+            size_t length = (getLookback(point) + budget + granularity - 1) / granularity * granularity;
+            lengths.push_back(last ? data.size() : std::min(data.size(), length));
+        }
+        size_t keep = last ? options.topK
+                           : static_cast<size_t>(std::ceil(candidates.size() / halving.eta));
+        rungOptions.topK = keep;
+
+        result = evaluate(data, strategyName, grid, &candidates, &lengths, initialCash, rungOptions, datasetKey);
+        evaluated += result.evaluated;
+        barsExecuted += result.barsExecuted;
+        if (last || result.cancelled) {
+            break;
+        }
+
+        // The best move up, then those that could not be ranked while there is room
+        std::vector<size_t> survivors;
+        for (size_t row : result.top) {
+            survivors.push_back(result.rows[row]);
+        }
+        const std::vector<double>& ranked = result.table.getColumn(options.metric);
+        for (size_t row = 0; row < ranked.size() && survivors.size() < keep; ++row) {
+            if (std::isnan(ranked[row])) {
+                survivors.push_back(result.rows[row]);
+            }
+        }
+        std::sort(survivors.begin(), survivors.end());
+        candidates = std::move(survivors);
+        if (options.onProgress) {
+            options.onProgress(static_cast<double>(rung + 1) / halving.rungs);
+        }
+    }
+
+    result.evaluated = evaluated;
+    result.barsExecuted = barsExecuted;
+    if (options.onProgress && !result.cancelled) {
+        options.onProgress(1.0);
+    }
+    return result;
+}
+
+SweepResult ParameterSweep::runGenetic(const MarketDataView& data,
+                                       const std::string& strategyName,
+                                       const ParameterGrid& grid,
+                                       double initialCash,
+                                       const SweepOptions& options,
+                                       const GeneticOptions& genetic,
+                                       const std::string& datasetKey) {
+    if (genetic.population == 0) {
+        throw std::invalid_argument("Genetic search needs a population");
+    }
+    const std::vector<ParameterAxis>& axes = grid.getAxes();
+    std::mt19937_64 rng(genetic.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    SweepResult result;
+    result.grid = grid;
+    std::vector<double> scores;                     // By table row
+    std::unordered_map<size_t, size_t> evaluatedAt; // Grid point -> table row
+    auto scoreOfPoint = [&](size_t point) { return scores[evaluatedAt.at(point)]; };
+
+    // Runs the points of `population` not seen before; false once cancelled
+    SweepOptions generationOptions;
+    generationOptions.metric = options.metric;
+    generationOptions.topK = 0;
+    generationOptions.cancelled = options.cancelled;
+    auto evaluatePopulation = [&](const std::vector<size_t>& population) {
+        std::vector<size_t> fresh;
+        for (size_t point : population) {
+            if (!evaluatedAt.count(point)) {
+                fresh.push_back(point);
+            }
+        }
+        std::sort(fresh.begin(), fresh.end());
+        fresh.erase(std::unique(fresh.begin(), fresh.end()), fresh.end());
+        SweepResult generation = evaluate(data, strategyName, grid, &fresh, nullptr, initialCash,
+                                          generationOptions, datasetKey);
+        result.evaluated += generation.evaluated;
+        result.barsExecuted += generation.barsExecuted;
+        if (generation.cancelled) {
+            return false;
+        }
+        const std::vector<double>& ranked = generation.table.getColumn(options.metric);
+        for (size_t row = 0; row < fresh.size(); ++row) {
+            evaluatedAt.emplace(fresh[row], result.rows.size());
+            result.rows.push_back(fresh[row]);
+            scores.push_back(scoreOf(options.metric, ranked[row]));
+        }
+        appendRows(result.table, generation.table);
+        if (result.failed == 0 && generation.failed > 0) {
+            result.firstError = generation.firstError;
+        }
+        result.failed += generation.failed;
+        return true;
+    };
+    // The best of three points drawn from the population
+    auto tournament = [&](const std::vector<size_t>& population) {
+        std::uniform_int_distribution<size_t> pick(0, population.size() - 1);
+        size_t best = population[pick(rng)];
+        for (int round = 0; round < 2; ++round) {
+            size_t other = population[pick(rng)];
+            if (scoreOfPoint(other) > scoreOfPoint(best)) {
+                best = other;
+            }
+        }
+        return best;
+    };
+
+    std::vector<size_t> population(genetic.population);
+    std::uniform_int_distribution<size_t> anyPoint(0, grid.size() - 1);
+    for (size_t& point : population) {
+        point = anyPoint(rng);
+    }
+    size_t generations = std::max<size_t>(1, genetic.generations);
+    std::vector<size_t> genes(axes.size());
+    for (size_t generation = 0; generation < generations; ++generation) {
+        if (!evaluatePopulation(population)) {
+            result.cancelled = true;
+            break;
+        }
+        if (options.onProgress) {
+            options.onProgress(static_cast<double>(generation + 1) / generations);
+        }
+        if (generation + 1 == generations) {
+            break;
+        }
+
+        std::vector<size_t> ranked = population;
+        std::sort(ranked.begin(), ranked.end(), [&](size_t a, size_t b) {
+            return scoreOfPoint(a) > scoreOfPoint(b) || (scoreOfPoint(a) == scoreOfPoint(b) && a < b);
+        });
+        ranked.erase(std::unique(ranked.begin(), ranked.end()), ranked.end());
+        std::vector<size_t> next(ranked.begin(), ranked.begin() + std::min(genetic.elite, ranked.size()));
+
+        // Mutation steps span a quarter of each axis at first and shrink to single steps
+        double spread = 0.25 * (1.0 - static_cast<double>(generation) / generations);
+        while (next.size() < genetic.population) {
+            size_t mother = tournament(population);
+            size_t father = tournament(population);
+            for (size_t axis = 0; axis < axes.size(); ++axis) {
+                size_t gene = grid.getAxisIndex(unit(rng) < 0.5 ? mother : father, axis);
+                size_t length = axes[axis].values.size();
+                if (length > 1 && unit(rng) < genetic.mutationRate) {
+                    double sigma = std::max(1.0, spread * static_cast<double>(length));
+                    long step = std::lround(std::normal_distribution<double>(0.0, sigma)(rng));
+                    if (step == 0) {
+                        step = unit(rng) < 0.5 ? -1 : 1;
+                    }
+                    long moved = static_cast<long>(gene) + step;
+                    gene = static_cast<size_t>(std::clamp<long>(moved, 0, static_cast<long>(length) - 1));
+                }
+                genes[axis] = gene;
+            }
+            next.push_back(grid.getIndex(genes));
+        }
+        population = std::move(next);
+    }
+
+    std::vector<Ranked> best;
+    const std::vector<double>& ranked = result.table.getColumn(options.metric);
+    for (size_t row = 0; row < scores.size(); ++row) {
+        if (!std::isnan(ranked[row])) {
+            best.push_back({scores[row], row});
+        }
+    }
+    std::sort(best.begin(), best.end(), ranksHigher);
+    best.resize(std::min(best.size(), options.topK));
+    for (const Ranked& entry : best) {
+        result.top.push_back(entry.row);
+    }
+    return result;
+}
+
+} // namespace fingraph
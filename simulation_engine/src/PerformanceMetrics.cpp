@@ -1,9 +1,10 @@
 #include "fingraph/PerformanceMetrics.h"
-#include "fingraph/Trade.h"
+#include "fingraph/TradeLog.h"
+#include "fingraph/indicators/Kernels.h"
+#include <algorithm>
 #include <vector>
 #include <cmath>
-#include <numeric>
-#include <map>
+#include <limits>
 
 namespace fingraph {
 
@@ -41,24 +42,25 @@ double PerformanceMetrics::calculateMaxDrawdown(
     return maxDrawdown;
 }
 
-double PerformanceMetrics::calculateWinRate(const std::vector<Trade>& trades) {
+double PerformanceMetrics::calculateWinRate(const TradeLog& trades) {
     if (trades.empty() || trades.size() < 2) return 0.0;
 
     int profitableTrades = 0;
     // We need to pair buys and sells to calculate profit/loss
-    std::map<std::string, double> openPositions; // symbol -> buy price
+    std::vector<double> openPrices; // Buy price by symbol id, NaN when flat
 
     for (const auto& trade : trades) {
-        if (trade.getType() == TradeType::BUY) {
-            openPositions[trade.getSymbol()] = trade.getPrice();
-        } else { // SELL
-            auto it = openPositions.find(trade.getSymbol());
-            if (it != openPositions.end()) {
-                if (trade.getPrice() > it->second) {
-                    profitableTrades++;
-                }
-                openPositions.erase(it);
+        if (trade.symbol >= openPrices.size()) {
+            openPrices.resize(trade.symbol + 1, std::numeric_limits<double>::quiet_NaN());
+        }
+        double& openPrice = openPrices[trade.symbol];
+        if (trade.type == TradeType::BUY) {
+            openPrice = trade.price;
+        } else if (!std::isnan(openPrice)) { // SELL
+            if (trade.price > openPrice) {
+                profitableTrades++;
             }
+            openPrice = std::numeric_limits<double>::quiet_NaN();
         }
     }
     
@@ -74,25 +76,32 @@ double PerformanceMetrics::calculateSharpeRatio(
     double riskFreeRate) {
     if (equityCurve.size() < 2) return 0.0;
 
+    const IndicatorKernels& kernels = getIndicatorKernels();
+
     // 1. Calculate daily returns
+    std::vector<double> values(equityCurve.size());
+    for (size_t i = 0; i < equityCurve.size(); ++i) {
+        values[i] = equityCurve[i].second;
+    }
     std::vector<double> returns;
-    for (size_t i = 1; i < equityCurve.size(); ++i) {
-        double prevValue = equityCurve[i-1].second;
-        double currValue = equityCurve[i].second;
-        if (prevValue != 0) {
-            returns.push_back((currValue - prevValue) / prevValue);
+    if (std::find(values.begin(), values.end() - 1, 0.0) == values.end() - 1) {
+        returns.resize(values.size() - 1);
+        kernels.returns(values.data(), values.size(), returns.data());
+    } else {
+        // Bars following a zero value have no return
+        for (size_t i = 1; i < values.size(); ++i) {
+            if (values[i-1] != 0) {
+                returns.push_back((values[i] - values[i-1]) / values[i-1]);
+            }
         }
     }
 
     if (returns.empty()) return 0.0;
 
     // 2. Calculate average return and standard deviation of returns
-    double meanReturn = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
+    double meanReturn = kernels.sum(returns.data(), returns.size()) / returns.size();
     
-    double variance = 0.0;
-    for (double r : returns) {
-        variance += (r - meanReturn) * (r - meanReturn);
-    }
+    double variance = kernels.sumSquaredDeviations(returns.data(), returns.size(), meanReturn);
     double stdDev = std::sqrt(variance / returns.size());
 
     // 3. Annualize and calculate Sharpe Ratio
@@ -105,4 +114,45 @@ double PerformanceMetrics::calculateSharpeRatio(
     return (annualizedMeanReturn - riskFreeRate) / annualizedStdDev;
 }
 
+void EquityCurveAccumulator::add(double value) {
+    if (count_ == 0) {
+        first_ = value;
+        peak_ = value;
+    } else if (last_ != 0) {
+        double r = (value - last_) / last_;
+        ++returnCount_;
+        double delta = r - meanReturn_;
+        meanReturn_ += delta / returnCount_;
+        squaredDeviations_ += delta * (r - meanReturn_);
+    }
+    ++count_;
+    last_ = value;
+
+    if (value > peak_) {
+        peak_ = value;
+    }
+    double drawdown = (peak_ - value) / peak_;
+    if (drawdown > maxDrawdown_) {
+        maxDrawdown_ = drawdown;
+    }
+}
+
+double EquityCurveAccumulator::getTotalReturn() const {
+    if (count_ == 0 || first_ == 0) return 0.0;
+    return (last_ - first_) / first_;
+}
+
+double EquityCurveAccumulator::getSharpeRatio(double riskFreeRate) const {
+    if (count_ < 2 || returnCount_ == 0) return 0.0;
+
+    // Same annualization as calculateSharpeRatio: daily data, 252 trading days
+    double stdDev = std::sqrt(squaredDeviations_ / returnCount_);
+    double annualizedMeanReturn = meanReturn_ * 252;
+    double annualizedStdDev = stdDev * std::sqrt(252);
+
+    if (annualizedStdDev == 0) return 0.0;
+
+    return (annualizedMeanReturn - riskFreeRate) / annualizedStdDev;
+}
+
 } // namespace fingraph
\ No newline at end of file
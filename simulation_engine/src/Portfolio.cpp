@@ -1,49 +1,148 @@
 #include "fingraph/Portfolio.h"
 #include "fingraph/Trade.h"
+#include <cmath>
+#include <stdexcept>
 
 namespace fingraph {
 
 Portfolio::Portfolio(double initialCash) : cash_(initialCash) {}
 
 void Portfolio::addTrade(const Trade& trade) {
-    trades_.push_back(trade);
-    
+    SymbolId symbol = internSymbol(trade.getSymbol());
+    addTrade(TradeRecord{trade.getTimestamp(), trade.getQuantity(), trade.getPrice(), symbol, trade.getType()});
+}
+
+void Portfolio::addTrade(const TradeRecord& trade, double commission) {
+    if (trade.symbol >= positions_.size()) {
+        throw std::out_of_range("addTrade: symbol id was not interned by this portfolio");
+    }
     double tradeValue = trade.getValue();
-    
-    if (trade.getType() == TradeType::BUY) {
+    double position = positions_[trade.symbol];
+
+    if (trade.type == TradeType::BUY) {
         // For a BUY, we spend cash and gain a position
-        if (cash_ < tradeValue) {
+        if (cash_ < tradeValue + commission) {
             throw std::runtime_error("Insufficient cash for trade.");
         }
         cash_ -= tradeValue;
-        positions_[trade.getSymbol()] += trade.getQuantity();
+        position += trade.quantity;
     } else { // SELL
         // For a SELL, we gain cash and reduce a position
-        if (getPosition(trade.getSymbol()) < trade.getQuantity()) {
+        if (position < trade.quantity) {
             throw std::runtime_error("Insufficient position for sell trade.");
         }
         cash_ += tradeValue;
-        positions_[trade.getSymbol()] -= trade.getQuantity();
+        position -= trade.quantity;
+    }
+    if (commission != 0) {
+        cash_ -= commission;
+        commissions_ += commission;
+    }
+    trades_.push_back(trade);
+
+    setPosition(trade.symbol, position);
+    prices_[trade.symbol] = trade.price;
+    double holding = position * trade.price;
+    addToMarketValue(holding - holdings_[trade.symbol]);
+    holdings_[trade.symbol] = holding;
+    if (++updatesSinceResync_ >= kResyncInterval) {
+        resyncMarketValue();
+    }
+}
+
+SymbolId Portfolio::internSymbol(const std::string& symbol) {
+    SymbolId id = symbols_.intern(symbol);
+    ensureSymbol(id);
+    return id;
+}
+
+void Portfolio::ensureSymbol(SymbolId symbol) {
+    if (symbol >= positions_.size()) {
+        positions_.resize(symbol + 1, 0.0);
+        prices_.resize(symbol + 1, 0.0);
+        holdings_.resize(symbol + 1, 0.0);
+        heldIndex_.resize(symbol + 1, kNotHeld);
+    }
+}
+
+void Portfolio::setPosition(SymbolId symbol, double position) {
+    positions_[symbol] = position;
+    uint32_t& index = heldIndex_[symbol];
+    if (position != 0 && index == kNotHeld) {
+        index = static_cast<uint32_t>(heldSymbols_.size());
+        heldSymbols_.push_back(symbol);
+    } else if (position == 0 && index != kNotHeld) {
+        // Swap-remove, keeping the moved symbol's index current
+        SymbolId last = heldSymbols_.back();
+        heldSymbols_[index] = last;
+        heldIndex_[last] = index;
+        heldSymbols_.pop_back();
+        index = kNotHeld;
     }
 }
 
 double Portfolio::getPosition(const std::string& symbol) const {
-    auto it = positions_.find(symbol);
-    if (it != positions_.end()) {
-        return it->second;
+    return getPosition(symbols_.find(symbol)); // 0 if no position is held
+}
+
+void Portfolio::updatePrice(SymbolId symbol, double price) {
+    if (symbol >= prices_.size()) {
+        throw std::out_of_range("updatePrice: symbol id was not interned by this portfolio");
+    }
+    if (std::isnan(price)) {
+        return;
+    }
+    prices_[symbol] = price;
+    double position = positions_[symbol];
+    if (position == 0) {
+        return;
+    }
+    double holding = position * price;
+    addToMarketValue(holding - holdings_[symbol]);
+    holdings_[symbol] = holding;
+    if (++updatesSinceResync_ >= kResyncInterval) {
+        resyncMarketValue();
+    }
+}
+
+void Portfolio::updatePrices(std::span<const SymbolId> symbols, std::span<const double> prices) {
+    if (symbols.size() != prices.size()) {
+        throw std::invalid_argument("updatePrices: symbols and prices differ in length");
+    }
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        updatePrice(symbols[i], prices[i]);
+    }
+}
+
+void Portfolio::updatePrices(std::span<const double> prices) {
+    for (size_t i = 0; i < prices.size(); ++i) {
+        updatePrice(static_cast<SymbolId>(i), prices[i]);
+    }
+}
+
+void Portfolio::addToMarketValue(double delta) {
+    double total = marketValue_ + delta;
+    marketValueCompensation_ += std::abs(marketValue_) >= std::abs(delta) ? (marketValue_ - total) + delta
+                                                                         : (delta - total) + marketValue_;
+    marketValue_ = total;
+}
+
+void Portfolio::resyncMarketValue() {
+    marketValue_ = 0.0;
+    marketValueCompensation_ = 0.0;
+    for (SymbolId symbol : heldSymbols_) {
+        holdings_[symbol] = positions_[symbol] * prices_[symbol];
+        addToMarketValue(holdings_[symbol]);
     }
-    return 0.0; // Return 0 if no position is held
+    updatesSinceResync_ = 0;
 }
 
 double Portfolio::getEquityValue(const std::map<std::string, double>& currentPrices) const {
     double totalEquity = 0.0;
-    for (const auto& pair : positions_) {
-        const std::string& symbol = pair.first;
-        double quantity = pair.second;
-        
-        auto priceIt = currentPrices.find(symbol);
+    for (SymbolId symbol : heldSymbols_) {
+        auto priceIt = currentPrices.find(symbols_.getName(symbol));
         if (priceIt != currentPrices.end()) {
-            totalEquity += quantity * priceIt->second;
+            totalEquity += positions_[symbol] * priceIt->second;
         }
     }
     return totalEquity;
@@ -53,4 +152,4 @@ double Portfolio::getTotalValue(const std::map<std::string, double>& currentPric
     return cash_ + getEquityValue(currentPrices);
 }
 
-} // namespace fingraph
\ No newline at end of file
+} // namespace fingraph
@@ -0,0 +1,83 @@
+#include "fingraph/Resampler.h"
+#include <stdexcept>
+#include <vector>
+
+namespace fingraph {
+
+namespace {
+
+// Floor division, so that buckets before the origin are still barSeconds wide.
+int64_t bucketOf(int64_t timestamp, int64_t originSeconds, int64_t barSeconds) {
+    int64_t offset = timestamp - originSeconds;
+    int64_t bucket = offset / barSeconds;
+    return (offset % barSeconds < 0) ? bucket - 1 : bucket;
+}
+
+} // namespace
+
+void Resampler::resample(const MarketDataView& data, int64_t barSeconds, ColumnBuffers& out,
+                         int64_t originSeconds) {
+    if (barSeconds <= 0) {
+        throw std::invalid_argument("Resampling bar size must be positive");
+    }
+    out.clear();
+    if (data.empty()) {
+        return;
+    }
+
+    // Pass over the timestamps only: where does each output bar start?
+    auto timestamps = data.getTimestamps();
+    std::vector<size_t> starts;
+    int64_t current = bucketOf(timestamps[0], originSeconds, barSeconds);
+    starts.push_back(0);
+    out.timestamps.push_back(originSeconds + current * barSeconds);
+    for (size_t i = 1; i < timestamps.size(); ++i) {
+        int64_t bucket = bucketOf(timestamps[i], originSeconds, barSeconds);
+        if (bucket != current) {
+            current = bucket;
+            starts.push_back(i);
+            out.timestamps.push_back(originSeconds + current * barSeconds);
+        }
+    }
+    size_t bars = starts.size();
+    starts.push_back(timestamps.size());
+
+    // Then one tight reduction per column and segment
+    auto opens = data.getOpens();
+    auto highs = data.getHighs();
+    auto lows = data.getLows();
+    auto closes = data.getCloses();
+    auto volumes = data.getVolumes();
+    out.open.resize(bars);
+    out.high.resize(bars);
+    out.low.resize(bars);
+    out.close.resize(bars);
+    out.volume.resize(bars);
+    for (size_t b = 0; b < bars; ++b) {
+        out.open[b] = opens[starts[b]];
+        out.close[b] = closes[starts[b + 1] - 1];
+    }
+    for (size_t b = 0; b < bars; ++b) {
+        double high = highs[starts[b]];
+        for (size_t i = starts[b] + 1; i < starts[b + 1]; ++i) {
+            high = highs[i] > high ? highs[i] : high;
+        }
+        out.high[b] = high;
+    }
+    for (size_t b = 0; b < bars; ++b) {
+        double low = lows[starts[b]];
+        for (size_t i = starts[b] + 1; i < starts[b + 1]; ++i) {
+            low = lows[i] < low ? lows[i] : low;
+        }
+        out.low[b] = low;
+    }
+    for (size_t b = 0; b < bars; ++b) {
+        uint64_t volume = 0;
+        for (size_t i = starts[b]; i < starts[b + 1]; ++i) {
+            volume += volumes[i];
+        }
+        out.volume[b] = volume;
+    }
+}
+
+} // namespace fingraph
@@ -5,9 +5,9 @@
 
 namespace fingraph {
 
-SimulationEngineServer::SimulationEngineServer(size_t max_concurrent_jobs)
+SimulationEngineServer::SimulationEngineServer(size_t max_concurrent_jobs, size_t dataset_cache_bytes)
     : running_(false) {
-    job_manager_ = std::make_unique<JobManager>(max_concurrent_jobs);
+    job_manager_ = std::make_unique<JobManager>(max_concurrent_jobs, dataset_cache_bytes);
     initializeStrategies();
 }
 
@@ -0,0 +1,18 @@
+#include "fingraph/SymbolTable.h"
+
+namespace fingraph {
+
+SymbolId SymbolTable::intern(const std::string& symbol) {
+    auto [it, inserted] = ids_.try_emplace(symbol, static_cast<SymbolId>(names_.size()));
+    if (inserted) {
+        names_.push_back(symbol);
+    }
+    return it->second;
+}
+
+SymbolId SymbolTable::find(const std::string& symbol) const {
+    auto it = ids_.find(symbol);
+    return it != ids_.end() ? it->second : kNotFound;
+}
+
+} // namespace fingraph
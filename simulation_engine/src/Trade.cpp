@@ -6,4 +6,8 @@ fingraph::Trade::Trade(const std::string& symbol, TradeType type, double quantit
     // Constructor body can be empty due to member initializer list
 }
 
+const char* fingraph::toString(TradeType type) {
+    return type == TradeType::BUY ? "BUY" : "SELL";
+}
+
 // namespace fingraph
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "fingraph/TradeLog.h"
+#include <utility>
+
+namespace fingraph {
+
+TradeLog::TradeLog(const TradeLog& other) {
+    *this = other;
+}
+
+TradeLog& TradeLog::operator=(const TradeLog& other) {
+    if (this != &other) {
+        clear();
+        reserve(other.size_);
+        for (const TradeRecord& record : other) {
+            push_back(record);
+        }
+    }
+    return *this;
+}
+
+TradeLog::TradeLog(TradeLog&& other) noexcept
+    : blocks_(std::move(other.blocks_)), size_(std::exchange(other.size_, 0)),
+      capacity_(std::exchange(other.capacity_, 0)) {
+}
+
+TradeLog& TradeLog::operator=(TradeLog&& other) noexcept {
+    if (this != &other) {
+        blocks_ = std::move(other.blocks_);
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, 0);
+        other.blocks_.clear();
+    }
+    return *this;
+}
+
+void TradeLog::reserve(size_t records) {
+    while (capacity_ < records) {
+        addBlock();
+    }
+}
+
+void TradeLog::addBlock() {
+    size_t records = kFirstBlockRecords << blocks_.size();
+    // for_overwrite: records are written by push_back before they are read
+    blocks_.push_back(std::make_unique_for_overwrite<TradeRecord[]>(records));
+    capacity_ += records;
+}
+
+} // namespace fingraph
@@ -0,0 +1,184 @@
+#include "fingraph/WalkForward.h"
+#include "fingraph/PerformanceMetrics.h"
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <stdexcept>
+
+namespace fingraph {
+
+namespace {
+
+// Names a slice of the bars `datasetKey` identifies, for the indicator cache.
+std::string sliceKey(const std::string& datasetKey, size_t begin, size_t size) {
+    if (datasetKey.empty()) {
+        return {};
+    }
+    return datasetKey + "[" + std::to_string(begin) + "+" + std::to_string(size) + "]";
+}
+
+} // namespace
+
+WalkForward::WalkForward(BacktestEngine& engine, ThreadPool& pool)
+    : engine_(engine), pool_(pool) {}
+
+WalkForwardResult WalkForward::run(const MarketDataView& data,
+                                   const std::string& strategyName,
+                                   const ParameterGrid& grid,
+                                   double initialCash,
+                                   const WalkForwardOptions& options,
+                                   const std::string& datasetKey) {
+    if (options.inSampleBars == 0 || options.outOfSampleBars == 0) {
+        throw std::invalid_argument("Walk-forward windows must not be empty");
+    }
+    if (options.inSampleBars >= data.size()) {
+        throw std::invalid_argument("Walk-forward in-sample window leaves no bars to test");
+    }
+
+    WalkForwardResult result;
+    for (size_t begin = options.inSampleBars; begin < data.size(); begin += options.outOfSampleBars) {
+        WalkForwardFold fold;
+        fold.inSampleBegin = options.anchored ? 0 : begin - options.inSampleBars;
+        fold.inSampleEnd = begin;
+        fold.outOfSampleBegin = begin;
+        fold.outOfSampleEnd = std::min(begin + options.outOfSampleBars, data.size());
+        result.folds.push_back(fold);
+    }
+
+    size_t count = result.folds.size();
+    std::vector<BacktestResult> tests(count);
+    std::vector<size_t> bars(count, 0);
+    {
+        // The fold threads wait on searches running on pool_, so they need a pool of their own
+        ThreadPool folds(std::min(count, ThreadPool::hardwareThreads()));
+        std::vector<std::future<void>> futures;
+        futures.reserve(count);
+        for (size_t k = 0; k < count; ++k) {
+            futures.push_back(folds.submit([&, k] {
+                tests[k] = runFold(data, strategyName, grid, initialCash, options, datasetKey,
+                                   result.folds[k], bars[k]);
+            }));
+        }
+        // Every fold must finish before unwinding: they all reference this frame
+        std::exception_ptr error;
+        for (size_t k = 0; k < count; ++k) {
+            try {
+                futures[k].get();
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            if (options.onProgress) {
+                options.onProgress(static_cast<double>(k + 1) / count);
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    result.cancelled = options.cancelled != nullptr && options.cancelled->load();
+
+    // Chain the folds: each one's curve is scaled to the capital the previous one left
+    BacktestResult& stitched = result.outOfSample;
+    stitched.equityCurve.reserve(data.size() - options.inSampleBars);
+    double capital = initialCash;
+    for (size_t k = 0; k < count; ++k) {
+        const BacktestResult& test = tests[k];
+        double scale = capital / initialCash;
+        for (const auto& [timestamp, value] : test.equityCurve) {
+            stitched.equityCurve.emplace_back(timestamp, value * scale);
+        }
+        for (const TradeRecord& trade : test.trades) {
+            TradeRecord scaled = trade;
+            scaled.symbol = stitched.symbols.intern(test.symbols.getName(trade.symbol));
+            scaled.quantity *= scale;
+            stitched.trades.push_back(scaled);
+        }
+        stitched.totalCosts += test.totalCosts * scale;
+        if (!test.equityCurve.empty()) {
+            capital = test.equityCurve.back().second * scale;
+        }
+        result.barsExecuted += bars[k];
+    }
+    stitched.totalReturn = PerformanceMetrics::calculateTotalReturn(stitched.equityCurve);
+    stitched.maxDrawdown = PerformanceMetrics::calculateMaxDrawdown(stitched.equityCurve);
+    stitched.sharpeRatio = PerformanceMetrics::calculateSharpeRatio(stitched.equityCurve);
+    stitched.winRate = PerformanceMetrics::calculateWinRate(stitched.trades);
+    return result;
+}
+
+BacktestResult WalkForward::runFold(const MarketDataView& data, const std::string& strategyName,
+                                    const ParameterGrid& grid, double initialCash,
+                                    const WalkForwardOptions& options, const std::string& datasetKey,
+                                    WalkForwardFold& fold, size_t& barsExecuted) {
+    // A fold without parameters to trade holds its cash through the test
+    auto holdCash = [&](std::string error) {
+        fold.error = std::move(error);
+        BacktestResult flat;
+        auto timestamps = data.getTimestamps();
+        for (size_t i = fold.outOfSampleBegin; i < fold.outOfSampleEnd; ++i) {
+            flat.equityCurve.emplace_back(toTimePoint(timestamps[i]), initialCash);
+        }
+        return flat;
+    };
+
+    size_t inSampleSize = fold.inSampleEnd - fold.inSampleBegin;
+    MarketDataView inSample = data.slice(fold.inSampleBegin, inSampleSize);
+    std::string inSampleKey = sliceKey(datasetKey, fold.inSampleBegin, inSampleSize);
+    SweepOptions sweepOptions;
+    sweepOptions.metric = options.metric;
+    sweepOptions.topK = 1;
+    sweepOptions.cancelled = options.cancelled;
+    ParameterSweep sweep(engine_, pool_);
+    SweepResult search;
+    switch (options.mode) {
+        case SweepMode::GRID:
+            search = sweep.run(inSample, strategyName, grid, initialCash, sweepOptions, inSampleKey);
+            break;
+        case SweepMode::SUCCESSIVE_HALVING:
+            search = sweep.runSuccessiveHalving(inSample, strategyName, grid, initialCash, sweepOptions,
+                                                options.halving, inSampleKey);
+            break;
+        case SweepMode::GENETIC:
+            search = sweep.runGenetic(inSample, strategyName, grid, initialCash, sweepOptions,
+                                      options.genetic, inSampleKey);
+            break;
+    }
+    barsExecuted += search.barsExecuted;
+    if (search.cancelled) {
+        return holdCash("Cancelled");
+    }
+    if (search.top.empty()) {
+        return holdCash("No parameters ran in sample" +
+                        (search.firstError.empty() ? std::string() : ": " + search.firstError));
+    }
+    size_t row = search.top.front();
+    fold.gridIndex = search.getGridIndex(row);
+    grid.getPoint(fold.gridIndex, fold.parameters);
+    fold.inSampleValue = search.table.getColumn(options.metric)[row];
+
+    // Start the lookback early so the indicators are warm on the first test bar;
+    // a strategy needing the whole history gets all of it
+    size_t lookback = engine_.getMaxLookback(strategyName, fold.parameters);
+    size_t warmup = std::min(lookback, fold.outOfSampleBegin);
+    size_t begin = fold.outOfSampleBegin - warmup;
+    MarketDataView window = data.slice(begin, fold.outOfSampleEnd - begin);
+    BacktestResult test;
+    try {
+        test = engine_.runBacktest(window, strategyName, fold.parameters, initialCash,
+                                   sliceKey(datasetKey, begin, window.size()));
+    } catch (const std::exception& e) {
+        return holdCash(std::string("Out-of-sample test failed: ") + e.what());
+    }
+    barsExecuted += window.size();
+
+    test.equityCurve.erase(test.equityCurve.begin(), test.equityCurve.begin() + warmup);
+    fold.totalReturn = PerformanceMetrics::calculateTotalReturn(test.equityCurve);
+    fold.sharpeRatio = PerformanceMetrics::calculateSharpeRatio(test.equityCurve);
+    fold.maxDrawdown = PerformanceMetrics::calculateMaxDrawdown(test.equityCurve);
+    fold.tradeCount = test.trades.size();
+    return test;
+}
+
+} // namespace fingraph
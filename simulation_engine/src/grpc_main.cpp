@@ -22,6 +22,7 @@ int main(int argc, char* argv[]) {
     // Parse command line arguments
     std::string server_address = "0.0.0.0:50051";
     size_t max_concurrent_jobs = 4;
+    size_t dataset_cache_mb = fingraph::DatasetCache::kDefaultByteBudget >> 20;
     
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -29,12 +30,16 @@ int main(int argc, char* argv[]) {
             server_address = argv[++i];
         } else if (arg == "--max-jobs" && i + 1 < argc) {
             max_concurrent_jobs = std::stoul(argv[++i]);
+        } else if (arg == "--dataset-cache-mb" && i + 1 < argc) {
+            dataset_cache_mb = std::stoul(argv[++i]);
         } else if (arg == "--help") {
             std::cout << "FinGraph Simulation Engine gRPC Server" << std::endl;
             std::cout << "Usage: " << argv[0] << " [options]" << std::endl;
             std::cout << "Options:" << std::endl;
             std::cout << "  --address <addr>  Server address (default: 0.0.0.0:50051)" << std::endl;
             std::cout << "  --max-jobs <num>  Maximum concurrent jobs (default: 4)" << std::endl;
+            std::cout << "  --dataset-cache-mb <num>  Memory budget for shared market data (default: "
+                      << dataset_cache_mb << ")" << std::endl;
             std::cout << "  --help           Show this help message" << std::endl;
             return 0;
         }
@@ -42,11 +47,13 @@ int main(int argc, char* argv[]) {
     
     try {
         // Create and configure the server
-        g_server = std::make_unique<fingraph::SimulationEngineServer>(max_concurrent_jobs);
+        g_server = std::make_unique<fingraph::SimulationEngineServer>(max_concurrent_jobs,
+                                                                      dataset_cache_mb << 20);
         
         std::cout << "Starting FinGraph Simulation Engine gRPC Server..." << std::endl;
         std::cout << "Server address: " << server_address << std::endl;
         std::cout << "Max concurrent jobs: " << max_concurrent_jobs << std::endl;
+        std::cout << "Dataset cache budget: " << dataset_cache_mb << " MB" << std::endl;
         
         // Start the server
         if (!g_server->start(server_address)) {
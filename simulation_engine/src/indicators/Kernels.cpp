@@ -0,0 +1,118 @@
+#include "fingraph/indicators/Kernels.h"
+#include "fingraph/indicators/MovingAverages.h"
+#include "SimdKernels.h"
+#include <algorithm>
+
+namespace fingraph {
+
+namespace {
+
+void scalarRollingSum(const double* in, size_t n, size_t period, double scale, double* out) {
+    RollingSum sum(period);
+    for (size_t i = 0; i < n; ++i) {
+        double value = sum.update(in[i]);
+        out[i] = sum.isReady() ? value * scale : kIndicatorWarmingUp;
+    }
+}
+
+void scalarPriceChanges(const double* prices, size_t n, double* gains, double* losses) {
+    if (n == 0) {
+        return;
+    }
+    gains[0] = 0.0;
+    losses[0] = 0.0;
+    for (size_t i = 1; i < n; ++i) {
+        double change = prices[i] - prices[i - 1];
+        gains[i] = change > 0 ? change : 0.0;
+        losses[i] = -change > 0 ? -change : 0.0;
+    }
+}
+
+void scalarRelativeStrength(const double* gainSums, const double* lossSums, size_t n, double* out) {
+    for (size_t i = 0; i < n; ++i) {
+        double gain = std::max(gainSums[i], 0.0);
+        double loss = std::max(lossSums[i], 0.0);
+        out[i] = loss > 0 ? 100.0 * gain / (gain + loss) : kRsiWithoutLosses;
+    }
+}
+
+void scalarReturns(const double* values, size_t n, double* out) {
+    for (size_t i = 0; i + 1 < n; ++i) {
+        out[i] = (values[i + 1] - values[i]) / values[i];
+    }
+}
+
+void scalarCrossovers(const double* a, const double* b, size_t n, int8_t* out) {
+    if (n == 0) {
+        return;
+    }
+    out[0] = 0;
+    for (size_t i = 1; i < n; ++i) {
+        bool up = a[i - 1] < b[i - 1] && a[i] > b[i];
+        bool down = a[i - 1] > b[i - 1] && a[i] < b[i];
+        out[i] = static_cast<int8_t>(up - down);
+    }
+}
+
+void scalarThresholds(const double* in, size_t n, double low, double high, int8_t* out) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = in[i] <= low ? 1 : in[i] >= high ? -1 : 0;
+    }
+}
+
+double scalarSum(const double* in, size_t n) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += in[i];
+    }
+    return sum;
+}
+
+double scalarSumSquaredDeviations(const double* in, size_t n, double mean) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += (in[i] - mean) * (in[i] - mean);
+    }
+    return sum;
+}
+
+const IndicatorKernels kScalarKernels = {
+    "scalar",
+    scalarRollingSum,
+    scalarPriceChanges,
+    scalarRelativeStrength,
+    scalarReturns,
+    scalarCrossovers,
+    scalarThresholds,
+    scalarSum,
+    scalarSumSquaredDeviations,
+};
+
+} // namespace
+
+const IndicatorKernels& getScalarIndicatorKernels() {
+    return kScalarKernels;
+}
+
+std::vector<const IndicatorKernels*> getSupportedIndicatorKernels() {
+    std::vector<const IndicatorKernels*> supported = {&kScalarKernels};
+#if FINGRAPH_X86_KERNELS
+    __builtin_cpu_init();
+    supported.push_back(&getSse2IndicatorKernels());
+    if (__builtin_cpu_supports("avx2")) {
+        supported.push_back(&getAvx2IndicatorKernels());
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        supported.push_back(&getAvx512IndicatorKernels());
+    }
+#endif
+    return supported;
+}
+
+const IndicatorKernels& getIndicatorKernels() {
+    // The last supported flavour is the widest
+    static const IndicatorKernels& selected = *getSupportedIndicatorKernels().back();
+    return selected;
+}
+
+} // namespace fingraph
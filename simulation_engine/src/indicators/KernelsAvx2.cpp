@@ -0,0 +1,52 @@
+// Compiled with -mavx2; only called once CPUID reports AVX2.
+#include "SimdKernels.h"
+
+#if FINGRAPH_X86_KERNELS
+#include <immintrin.h>
+
+namespace fingraph {
+
+namespace {
+
+struct Avx2 {
+    using V = __m256d;
+    static constexpr size_t kLanes = 4;
+
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+    static V set1(double x) { return _mm256_set1_pd(x); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static double first(V v) { return _mm256_cvtsd_f64(v); }
+    static double reduce(V v) {
+        __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    }
+    // [a, b, c, d] -> [a, a + b, a + b + c, a + b + c + d]: shift by one lane, then by two
+    static V prefixSum(V v) {
+        V shifted = _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), _mm256_setzero_pd(), 0b0001);
+        v = _mm256_add_pd(v, shifted);
+        return _mm256_add_pd(v, _mm256_permute2f128_pd(v, v, 0x08));
+    }
+    static V broadcastLast(V v) { return _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3)); }
+    static unsigned lessMask(V a, V b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ)); }
+    static unsigned lessEqualMask(V a, V b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ)); }
+    static V selectGreater(V a, V b, V ifTrue, V ifFalse) {
+        return _mm256_blendv_pd(ifFalse, ifTrue, _mm256_cmp_pd(a, b, _CMP_GT_OQ));
+    }
+};
+
+constexpr IndicatorKernels kAvx2Kernels = simd::makeKernels<Avx2>("avx2");
+
+} // namespace
+
+const IndicatorKernels& getAvx2IndicatorKernels() {
+    return kAvx2Kernels;
+}
+
+} // namespace fingraph
+
+#endif
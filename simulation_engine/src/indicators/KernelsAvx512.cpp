@@ -0,0 +1,57 @@
+// Compiled with -mavx512f; only called once CPUID reports AVX-512F.
+#include "SimdKernels.h"
+
+#if FINGRAPH_X86_KERNELS
+// GCC 12's AVX-512 intrinsics start from deliberately undefined vectors, which
+// -Wuninitialized reports at every use (GCC bug 105593)
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+
+namespace fingraph {
+
+namespace {
+
+struct Avx512 {
+    using V = __m512d;
+    static constexpr size_t kLanes = 8;
+
+    static V load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, V v) { _mm512_storeu_pd(p, v); }
+    static V set1(double x) { return _mm512_set1_pd(x); }
+    static V add(V a, V b) { return _mm512_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm512_div_pd(a, b); }
+    static V max(V a, V b) { return _mm512_max_pd(a, b); }
+    static double first(V v) { return _mm512_cvtsd_f64(v); }
+    static double reduce(V v) { return _mm512_reduce_add_pd(v); }
+    // Lane j += lane j - k for k = 1, 2, 4 (lanes below k add zero)
+    static V shiftUp(V v, int k, __mmask8 keep) {
+        __m512i index = _mm512_sub_epi64(_mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0), _mm512_set1_epi64(k));
+        return _mm512_maskz_permutexvar_pd(keep, index, v);
+    }
+    static V prefixSum(V v) {
+        v = _mm512_add_pd(v, shiftUp(v, 1, 0xFE));
+        v = _mm512_add_pd(v, shiftUp(v, 2, 0xFC));
+        return _mm512_add_pd(v, shiftUp(v, 4, 0xF0));
+    }
+    static V broadcastLast(V v) { return _mm512_permutexvar_pd(_mm512_set1_epi64(7), v); }
+    static unsigned lessMask(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static unsigned lessEqualMask(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+    static V selectGreater(V a, V b, V ifTrue, V ifFalse) {
+        return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, _CMP_GT_OQ), ifFalse, ifTrue);
+    }
+};
+
+constexpr IndicatorKernels kAvx512Kernels = simd::makeKernels<Avx512>("avx512");
+
+} // namespace
+
+const IndicatorKernels& getAvx512IndicatorKernels() {
+    return kAvx512Kernels;
+}
+
+} // namespace fingraph
+
+#endif
@@ -0,0 +1,46 @@
+#include "SimdKernels.h"
+
+#if FINGRAPH_X86_KERNELS
+#include <emmintrin.h>
+
+namespace fingraph {
+
+namespace {
+
+struct Sse2 {
+    using V = __m128d;
+    static constexpr size_t kLanes = 2;
+
+    static V load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, V v) { _mm_storeu_pd(p, v); }
+    static V set1(double x) { return _mm_set1_pd(x); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm_div_pd(a, b); }
+    static V max(V a, V b) { return _mm_max_pd(a, b); }
+    static double first(V v) { return _mm_cvtsd_f64(v); }
+    static double reduce(V v) { return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v))); }
+    // [a, b] -> [a, a + b]
+    static V prefixSum(V v) { return _mm_add_pd(v, _mm_unpacklo_pd(_mm_setzero_pd(), v)); }
+    static V broadcastLast(V v) { return _mm_unpackhi_pd(v, v); }
+    static unsigned lessMask(V a, V b) { return _mm_movemask_pd(_mm_cmplt_pd(a, b)); }
+    static unsigned lessEqualMask(V a, V b) { return _mm_movemask_pd(_mm_cmple_pd(a, b)); }
+    // a > b ? ifTrue : ifFalse, per lane
+    static V selectGreater(V a, V b, V ifTrue, V ifFalse) {
+        V mask = _mm_cmpgt_pd(a, b);
+        return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse));
+    }
+};
+
+constexpr IndicatorKernels kSse2Kernels = simd::makeKernels<Sse2>("sse2");
+
+} // namespace
+
+const IndicatorKernels& getSse2IndicatorKernels() {
+    return kSse2Kernels;
+}
+
+} // namespace fingraph
+
+#endif
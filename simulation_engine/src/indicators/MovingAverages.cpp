@@ -0,0 +1,134 @@
+#include "fingraph/indicators/MovingAverages.h"
+#include "fingraph/indicators/Kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace fingraph {
+
+RollingSum::RollingSum(size_t period) {
+    if (period == 0) {
+        throw std::invalid_argument("Indicator period must be positive");
+    }
+    window_.assign(period, 0.0);
+}
+
+void RollingSum::add(double value) {
+    double total = sum_ + value;
+    if (std::abs(sum_) >= std::abs(value)) {
+        compensation_ += (sum_ - total) + value;
+    } else {
+        compensation_ += (value - total) + sum_;
+    }
+    sum_ = total;
+}
+
+double RollingSum::update(double value) {
+    if (count_ == window_.size()) {
+        add(-window_[next_]);
+    } else {
+        count_++;
+    }
+    window_[next_] = value;
+    add(value);
+    next_ = next_ + 1 == window_.size() ? 0 : next_ + 1;
+    return getSum();
+}
+
+void RollingSum::reset() {
+    next_ = 0;
+    count_ = 0;
+    sum_ = 0.0;
+    compensation_ = 0.0;
+}
+
+double SimpleMovingAverage::update(double value) {
+    sum_.update(value);
+    return getValue();
+}
+
+void SimpleMovingAverage::compute(std::span<const double> input, std::span<double> output) {
+    checkIndicatorOutput(input.size(), output.size());
+    size_t period = getPeriod();
+    getIndicatorKernels().rollingSum(input.data(), input.size(), period, 1.0 / period, output.data());
+
+    // Leave the window as if every input had been pushed
+    reset();
+    for (size_t i = input.size() - std::min(input.size(), period); i < input.size(); ++i) {
+        sum_.update(input[i]);
+    }
+}
+
+ExponentialMovingAverage::ExponentialMovingAverage(size_t period)
+    : ExponentialMovingAverage(period, 2.0 / (period + 1.0)) {}
+
+ExponentialMovingAverage::ExponentialMovingAverage(size_t period, double alpha)
+    : period_(period), alpha_(alpha) {
+    if (period == 0) {
+        throw std::invalid_argument("Indicator period must be positive");
+    }
+}
+
+ExponentialMovingAverage ExponentialMovingAverage::wilder(size_t period) {
+    return ExponentialMovingAverage(period, period == 0 ? 0.0 : 1.0 / period);
+}
+
+double ExponentialMovingAverage::update(double value) {
+    if (count_ < period_) {
+        value_ += value;
+        if (++count_ == period_) {
+            value_ /= period_;
+        }
+    } else {
+        value_ += alpha_ * (value - value_);
+    }
+    return getValue();
+}
+
+void ExponentialMovingAverage::compute(std::span<const double> input, std::span<double> output) {
+    checkIndicatorOutput(input.size(), output.size());
+    reset();
+    for (size_t i = 0; i < input.size(); ++i) {
+        output[i] = update(input[i]);
+    }
+}
+
+void ExponentialMovingAverage::reset() {
+    count_ = 0;
+    value_ = 0.0;
+}
+
+Macd::Macd(size_t fastPeriod, size_t slowPeriod, size_t signalPeriod)
+    : fast_(fastPeriod), slow_(slowPeriod), signal_(signalPeriod) {}
+
+double Macd::update(double value) {
+    fast_.update(value);
+    slow_.update(value);
+    if (slow_.isReady()) {
+        line_ = fast_.getValue() - slow_.getValue();
+        signal_.update(line_);
+    }
+    return getValue();
+}
+
+void Macd::compute(std::span<const double> input, std::span<double> macd, std::span<double> signal,
+                   std::span<double> histogram) {
+    checkIndicatorOutput(input.size(), macd.size());
+    checkIndicatorOutput(input.size(), signal.size());
+    checkIndicatorOutput(input.size(), histogram.size());
+    reset();
+    for (size_t i = 0; i < input.size(); ++i) {
+        macd[i] = update(input[i]);
+        signal[i] = getSignal();
+        histogram[i] = getHistogram();
+    }
+}
+
+void Macd::reset() {
+    fast_.reset();
+    slow_.reset();
+    signal_.reset();
+    line_ = 0.0;
+}
+
+} // namespace fingraph
@@ -0,0 +1,88 @@
+#include "fingraph/indicators/Rsi.h"
+#include "fingraph/indicators/Kernels.h"
+#include <algorithm>
+#include <vector>
+
+namespace fingraph {
+
+RelativeStrengthIndex::RelativeStrengthIndex(size_t period, Smoothing smoothing)
+    : period_(period), smoothing_(smoothing),
+      wilderGain_(ExponentialMovingAverage::wilder(period)),
+      wilderLoss_(ExponentialMovingAverage::wilder(period)),
+      gainSum_(smoothing == Smoothing::Simple ? period : 1),
+      lossSum_(smoothing == Smoothing::Simple ? period : 1) {}
+
+double RelativeStrengthIndex::update(double price) {
+    if (hasPrevious_) {
+        double change = price - previous_;
+        double gain = change > 0 ? change : 0.0;
+        double loss = change < 0 ? -change : 0.0;
+        if (smoothing_ == Smoothing::Wilder) {
+            wilderGain_.update(gain);
+            wilderLoss_.update(loss);
+        } else {
+            gainSum_.update(gain);
+            lossSum_.update(loss);
+        }
+        changes_++;
+    }
+    hasPrevious_ = true;
+    previous_ = price;
+    return getValue();
+}
+
+double RelativeStrengthIndex::getValue() const {
+    if (!isReady()) {
+        return kIndicatorWarmingUp;
+    }
+    if (smoothing_ == Smoothing::Wilder) {
+        double gain = wilderGain_.getValue();
+        double total = gain + wilderLoss_.getValue();
+        return total > 0 ? 100.0 * gain / total : 50.0;
+    }
+    // Sums of non-negative values: clamp the rounding residue left by removals
+    double gain = std::max(gainSum_.getSum(), 0.0);
+    double loss = std::max(lossSum_.getSum(), 0.0);
+    return loss > 0 ? 100.0 * gain / (gain + loss) : kRsiWithoutLosses;
+}
+
+void RelativeStrengthIndex::compute(std::span<const double> prices, std::span<double> output) {
+    checkIndicatorOutput(prices.size(), output.size());
+    size_t n = prices.size();
+    if (smoothing_ == Smoothing::Wilder || n <= period_) {
+        // Wilder's recurrence is inherently sequential
+        reset();
+        for (size_t i = 0; i < n; ++i) {
+            output[i] = update(prices[i]);
+        }
+        return;
+    }
+
+    // Simple smoothing is a pipeline of vector kernels: changes, window sums, ratio
+    const IndicatorKernels& kernels = getIndicatorKernels();
+    std::vector<double> gains(n), losses(n);
+    kernels.priceChanges(prices.data(), n, gains.data(), losses.data());
+    // Window sums over changes 1..n-1: gain sums go to output, loss sums reuse `gains`
+    kernels.rollingSum(gains.data() + 1, n - 1, period_, 1.0, output.data() + 1);
+    kernels.rollingSum(losses.data() + 1, n - 1, period_, 1.0, gains.data() + 1);
+    kernels.relativeStrength(output.data() + period_, gains.data() + period_, n - period_, output.data() + period_);
+    output[0] = kIndicatorWarmingUp;
+
+    // Leave the state as if every price had been pushed
+    reset();
+    for (size_t i = n - period_ - 1; i < n; ++i) {
+        update(prices[i]);
+    }
+}
+
+void RelativeStrengthIndex::reset() {
+    hasPrevious_ = false;
+    previous_ = 0.0;
+    changes_ = 0;
+    wilderGain_.reset();
+    wilderLoss_.reset();
+    gainSum_.reset();
+    lossSum_.reset();
+}
+
+} // namespace fingraph
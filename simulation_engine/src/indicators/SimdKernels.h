@@ -0,0 +1,254 @@
+#pragma once
+// Shared implementation of the vector IndicatorKernels flavours. Each flavour's
+// translation unit is compiled for its instruction set, defines a traits struct
+// (vector type, lane count and the handful of operations below) and instantiates
+// makeKernels<Traits>(). Nothing here may be called before the CPUID check in
+// Kernels.cpp has accepted that flavour.
+//
+// Everything below has internal linkage and avoids out-of-line standard library
+// templates: an inline function compiled for AVX-512 in one translation unit
+// must never be the copy the linker picks for code that runs on any CPU.
+#include "fingraph/indicators/Indicator.h"
+#include "fingraph/indicators/Kernels.h"
+#include <cstdint>
+
+#if defined(__x86_64__) && defined(__GNUC__) // SSE2 is part of the x86-64 baseline
+#define FINGRAPH_X86_KERNELS 1
+#else
+#define FINGRAPH_X86_KERNELS 0
+#endif
+
+namespace fingraph {
+
+#if FINGRAPH_X86_KERNELS
+const IndicatorKernels& getSse2IndicatorKernels();
+const IndicatorKernels& getAvx2IndicatorKernels();
+const IndicatorKernels& getAvx512IndicatorKernels();
+
+namespace simd {
+namespace {
+
+// The vector rolling sum restarts from an exactly summed window this often, so
+// the rounding error of its uncompensated running sum stays bounded.
+inline constexpr size_t kRollingSumAnchorInterval = 4096;
+
+double magnitude(double x) {
+    return x < 0 ? -x : x;
+}
+
+double compensatedSum(const double* in, size_t n) {
+    double sum = 0.0, compensation = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double total = sum + in[i];
+        compensation += magnitude(sum) >= magnitude(in[i]) ? (sum - total) + in[i] : (in[i] - total) + sum;
+        sum = total;
+    }
+    return sum + compensation;
+}
+
+template <typename T>
+void rollingSum(const double* in, size_t n, size_t period, double scale, double* out) {
+    using V = typename T::V;
+    for (size_t i = 0; i < n && i + 1 < period; ++i) {
+        out[i] = kIndicatorWarmingUp;
+    }
+    const V scaleV = T::set1(scale);
+    for (size_t i = period - 1; i < n;) {
+        // out[i] = out[i - 1] + (in[i] - in[i - period]): the differences are
+        // independent, and a prefix sum across the lanes chains them together
+        double anchor = compensatedSum(in + i + 1 - period, period);
+        out[i] = anchor * scale;
+        size_t end = n - i > kRollingSumAnchorInterval ? i + kRollingSumAnchorInterval : n;
+        V carry = T::set1(anchor);
+        for (++i; i + T::kLanes <= end; i += T::kLanes) {
+            V running = T::add(carry, T::prefixSum(T::sub(T::load(in + i), T::load(in + i - period))));
+            T::store(out + i, T::mul(running, scaleV));
+            carry = T::broadcastLast(running);
+        }
+        double running = T::first(carry);
+        for (; i < end; ++i) {
+            running += in[i] - in[i - period];
+            out[i] = running * scale;
+        }
+    }
+}
+
+template <typename T>
+void priceChanges(const double* prices, size_t n, double* gains, double* losses) {
+    if (n == 0) {
+        return;
+    }
+    gains[0] = 0.0;
+    losses[0] = 0.0;
+    const typename T::V zero = T::set1(0.0);
+    size_t i = 1;
+    for (; i + T::kLanes <= n; i += T::kLanes) {
+        auto change = T::sub(T::load(prices + i), T::load(prices + i - 1));
+        // max returns its second operand for NaN and for +-0, matching the scalar `x > 0 ? x : 0`
+        T::store(gains + i, T::max(change, zero));
+        T::store(losses + i, T::max(T::sub(zero, change), zero));
+    }
+    for (; i < n; ++i) {
+        double change = prices[i] - prices[i - 1];
+        gains[i] = change > 0 ? change : 0.0;
+        losses[i] = -change > 0 ? -change : 0.0;
+    }
+}
+
+template <typename T>
+void relativeStrength(const double* gainSums, const double* lossSums, size_t n, double* out) {
+    const typename T::V zero = T::set1(0.0), hundred = T::set1(100.0), capped = T::set1(kRsiWithoutLosses);
+    size_t i = 0;
+    for (; i + T::kLanes <= n; i += T::kLanes) {
+        // max(0, x) returns x for NaN and -0, like `x < 0 ? 0 : x`
+        auto gain = T::max(zero, T::load(gainSums + i));
+        auto loss = T::max(zero, T::load(lossSums + i));
+        auto total = T::add(gain, loss);
+        T::store(out + i, T::selectGreater(loss, zero, T::div(T::mul(hundred, gain), total), capped));
+    }
+    for (; i < n; ++i) {
+        double gain = gainSums[i] < 0 ? 0.0 : gainSums[i];
+        double loss = lossSums[i] < 0 ? 0.0 : lossSums[i];
+        out[i] = loss > 0 ? 100.0 * gain / (gain + loss) : kRsiWithoutLosses;
+    }
+}
+
+template <typename T>
+void returns(const double* values, size_t n, double* out) {
+    size_t i = 0;
+    for (; i + T::kLanes < n; i += T::kLanes) {
+        auto current = T::load(values + i);
+        T::store(out + i, T::div(T::sub(T::load(values + i + 1), current), current));
+    }
+    for (; i + 1 < n; ++i) {
+        out[i] = (values[i + 1] - values[i]) / values[i];
+    }
+}
+
+// kLaneBytes.bytes[m] has byte j = bit j of m: a lane mask spread into one byte per lane.
+struct LaneBytes {
+    uint64_t bytes[256];
+    constexpr LaneBytes() : bytes() {
+        for (unsigned mask = 0; mask < 256; ++mask) {
+            for (unsigned lane = 0; lane < 8; ++lane) {
+                bytes[mask] |= uint64_t((mask >> lane) & 1) << (8 * lane);
+            }
+        }
+    }
+};
+constexpr LaneBytes kLaneBytes;
+
+// Lanes with +1 (up) and -1 (down) direction codes; never both.
+struct DirectionMasks {
+    unsigned up;
+    unsigned down;
+};
+
+// Writes direction codes for [begin, n) eight at a time, from the masks that
+// `masks(i)` returns for the vector starting at i; returns where it stopped.
+template <typename T, typename Masks>
+size_t storeDirections(size_t begin, size_t n, int8_t* out, Masks masks) {
+    size_t i = begin;
+    for (; i + 8 <= n; i += 8) {
+        unsigned up = 0, down = 0;
+        for (size_t lane = 0; lane < 8; lane += T::kLanes) {
+            DirectionMasks m = masks(i + lane);
+            up |= m.up << lane;
+            down |= m.down << lane;
+        }
+        uint64_t codes = kLaneBytes.bytes[up & 0xFF] | kLaneBytes.bytes[down & 0xFF] * 0xFF;
+        __builtin_memcpy(out + i, &codes, 8); // x86 is little-endian: code i is the low byte
+    }
+    return i;
+}
+
+template <typename T>
+void crossovers(const double* a, const double* b, size_t n, int8_t* out) {
+    if (n == 0) {
+        return;
+    }
+    out[0] = 0;
+    size_t i = storeDirections<T>(1, n, out, [a, b](size_t at) {
+        auto previousA = T::load(a + at - 1), previousB = T::load(b + at - 1);
+        auto currentA = T::load(a + at), currentB = T::load(b + at);
+        return DirectionMasks{T::lessMask(previousA, previousB) & T::lessMask(currentB, currentA),
+                              T::lessMask(previousB, previousA) & T::lessMask(currentA, currentB)};
+    });
+    for (; i < n; ++i) {
+        bool up = a[i - 1] < b[i - 1] && a[i] > b[i];
+        bool down = a[i - 1] > b[i - 1] && a[i] < b[i];
+        out[i] = static_cast<int8_t>(up - down);
+    }
+}
+
+template <typename T>
+void thresholds(const double* in, size_t n, double low, double high, int8_t* out) {
+    const typename T::V lowV = T::set1(low), highV = T::set1(high);
+    size_t i = storeDirections<T>(0, n, out, [in, lowV, highV](size_t at) {
+        auto values = T::load(in + at);
+        unsigned buy = T::lessEqualMask(values, lowV);
+        return DirectionMasks{buy, T::lessEqualMask(highV, values) & ~buy};
+    });
+    for (; i < n; ++i) {
+        out[i] = in[i] <= low ? 1 : in[i] >= high ? -1 : 0;
+    }
+}
+
+// Sums term(i) over [0, n): vector terms into four independent accumulators,
+// which hides the add latency, and the remainder with scalarTerm.
+template <typename T, typename Term, typename ScalarTerm>
+double reduceSum(size_t n, Term term, ScalarTerm scalarTerm) {
+    typename T::V acc[4] = {T::set1(0.0), T::set1(0.0), T::set1(0.0), T::set1(0.0)};
+    size_t i = 0;
+    for (; i + 4 * T::kLanes <= n; i += 4 * T::kLanes) {
+        for (size_t k = 0; k < 4; ++k) {
+            acc[k] = T::add(acc[k], term(i + k * T::kLanes));
+        }
+    }
+    for (; i + T::kLanes <= n; i += T::kLanes) {
+        acc[0] = T::add(acc[0], term(i));
+    }
+    double sum = T::reduce(T::add(T::add(acc[0], acc[1]), T::add(acc[2], acc[3])));
+    for (; i < n; ++i) {
+        sum += scalarTerm(i);
+    }
+    return sum;
+}
+
+template <typename T>
+double sum(const double* in, size_t n) {
+    return reduceSum<T>(n, [in](size_t i) { return T::load(in + i); }, [in](size_t i) { return in[i]; });
+}
+
+template <typename T>
+double sumSquaredDeviations(const double* in, size_t n, double mean) {
+    const typename T::V meanV = T::set1(mean);
+    return reduceSum<T>(
+        n,
+        [in, meanV](size_t i) {
+            auto deviation = T::sub(T::load(in + i), meanV);
+            return T::mul(deviation, deviation);
+        },
+        [in, mean](size_t i) { return (in[i] - mean) * (in[i] - mean); });
+}
+
+template <typename T>
+constexpr IndicatorKernels makeKernels(const char* name) {
+    return {
+        name,
+        rollingSum<T>,
+        priceChanges<T>,
+        relativeStrength<T>,
+        returns<T>,
+        crossovers<T>,
+        thresholds<T>,
+        sum<T>,
+        sumSquaredDeviations<T>,
+    };
+}
+
+} // namespace
+} // namespace simd
+#endif
+
+} // namespace fingraph
@@ -0,0 +1,91 @@
+#include "fingraph/indicators/Volatility.h"
+#include <algorithm>
+#include <cmath>
+
+namespace fingraph {
+
+RollingStdDev::RollingStdDev(size_t period) : sum_(period) {}
+
+double RollingStdDev::update(double value) {
+    double previousMean = mean_;
+    if (sum_.isReady()) {
+        // Replace the oldest value: M2 += (x - old) * (x - newMean + old - oldMean)
+        double oldest = sum_.getOldest();
+        sum_.update(value);
+        mean_ = sum_.getSum() / sum_.getCount();
+        squaredDeviations_ += (value - oldest) * (value - mean_ + oldest - previousMean);
+    } else {
+        sum_.update(value);
+        mean_ = sum_.getSum() / sum_.getCount();
+        squaredDeviations_ += (value - previousMean) * (value - mean_);
+    }
+    return getValue();
+}
+
+double RollingStdDev::getValue() const {
+    if (!isReady()) {
+        return kIndicatorWarmingUp;
+    }
+    return std::sqrt(std::max(squaredDeviations_, 0.0) / getPeriod());
+}
+
+void RollingStdDev::compute(std::span<const double> input, std::span<double> output) {
+    checkIndicatorOutput(input.size(), output.size());
+    reset();
+    for (size_t i = 0; i < input.size(); ++i) {
+        output[i] = update(input[i]);
+    }
+}
+
+void RollingStdDev::reset() {
+    sum_.reset();
+    mean_ = 0.0;
+    squaredDeviations_ = 0.0;
+}
+
+double BollingerBands::update(double value) {
+    stdDev_.update(value);
+    return getMiddle();
+}
+
+void BollingerBands::compute(std::span<const double> input, std::span<double> middle, std::span<double> upper,
+                             std::span<double> lower) {
+    checkIndicatorOutput(input.size(), middle.size());
+    checkIndicatorOutput(input.size(), upper.size());
+    checkIndicatorOutput(input.size(), lower.size());
+    reset();
+    for (size_t i = 0; i < input.size(); ++i) {
+        middle[i] = update(input[i]);
+        upper[i] = getUpper();
+        lower[i] = getLower();
+    }
+}
+
+double AverageTrueRange::update(double high, double low, double close) {
+    double range = high - low;
+    if (hasPrevious_) {
+        range = std::max({range, std::abs(high - previousClose_), std::abs(low - previousClose_)});
+    }
+    hasPrevious_ = true;
+    previousClose_ = close;
+    return average_.update(range);
+}
+
+void AverageTrueRange::compute(std::span<const double> highs, std::span<const double> lows,
+                               std::span<const double> closes, std::span<double> output) {
+    checkIndicatorOutput(highs.size(), lows.size());
+    checkIndicatorOutput(highs.size(), closes.size());
+    checkIndicatorOutput(highs.size(), output.size());
+    reset();
+    for (size_t i = 0; i < highs.size(); ++i) {
+        output[i] = update(highs[i], lows[i], closes[i]);
+    }
+}
+
+void AverageTrueRange::reset() {
+    average_.reset();
+    hasPrevious_ = false;
+    previousClose_ = 0.0;
+}
+
+} // namespace fingraph
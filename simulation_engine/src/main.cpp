@@ -2,6 +2,7 @@
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include "fingraph/Backtest.h"
+#include "fingraph/MarketDataStream.h"
 
 // For convenience
 using json = nlohmann::json;
@@ -26,12 +27,23 @@ int main(int argc, char* argv[]) {
         // 2. Initialize and Run Backtest Engine
         BacktestEngine engine;
         
-        BacktestResult result = engine.runBacktest(
-            config["dataPath"],
-            config["strategy"],
-            config["parameters"],
-            config["initialCash"]
-        );
+        BacktestResult result;
+        if (config.value("streaming", false)) {
+            // Constant memory for files larger than RAM; no equity curve is recorded
+            std::string dataPath = config["dataPath"];
+            auto stream = MarketDataStream::open(dataPath);
+            if (!stream) {
+                throw std::runtime_error("Failed to open market data " + dataPath);
+            }
+            result = engine.runBacktest(*stream, config["strategy"], config["parameters"], config["initialCash"]);
+        } else {
+            result = engine.runBacktest(
+                config["dataPath"],
+                config["strategy"],
+                config["parameters"],
+                config["initialCash"]
+            );
+        }
         
         // 3. Serialize Results to JSON
         json output;
@@ -39,16 +51,17 @@ int main(int argc, char* argv[]) {
         output["sharpeRatio"] = result.sharpeRatio;
         output["maxDrawdown"] = result.maxDrawdown;
         output["winRate"] = result.winRate;
+        output["totalCosts"] = result.totalCosts;
         
         json trades = json::array();
         for (const auto& trade : result.trades) {
             json t;
-            t["symbol"] = trade.getSymbol();
-            t["type"] = (trade.getType() == TradeType::BUY) ? "BUY" : "SELL";
-            t["quantity"] = trade.getQuantity();
-            t["price"] = trade.getPrice();
+            t["symbol"] = result.symbols.getName(trade.symbol);
+            t["type"] = toString(trade.type);
+            t["quantity"] = trade.quantity;
+            t["price"] = trade.price;
             t["timestamp"] = std::chrono::duration_cast<std::chrono::milliseconds>(
-                trade.getTimestamp().time_since_epoch()).count();
+                trade.timestamp.time_since_epoch()).count();
             trades.push_back(t);
         }
         output["trades"] = trades;
@@ -1,44 +1,54 @@
 #include "fingraph/strategies/MovingAverageStrategy.h"
-#include <numeric>
+#include "fingraph/indicators/Kernels.h"
+#include "fingraph/indicators/MovingAverages.h"
+#include <algorithm>
 #include <stdexcept>
+#include <string>
 
 namespace fingraph {
 
 MovingAverageStrategy::MovingAverageStrategy() 
     : Strategy("Moving Average Crossover"), shortPeriod_(10), longPeriod_(30) {}
 
-void MovingAverageStrategy::initialize(const std::vector<OHLCV>& data) {
+void MovingAverageStrategy::initialize(const MarketDataView& data) {
     if (data.size() < longPeriod_) {
         throw std::invalid_argument("Not enough data for long-period moving average.");
     }
     
     // Pre-calculate all moving averages to speed up signal generation
-    calculateMovingAverages(data);
+    calculateMovingAverages(data.getCloses());
 }
 
-Signal MovingAverageStrategy::generateSignal(size_t index) const {
-    // Cannot generate a signal before the long MA is fully calculated
-    if (index < longPeriod_ || index >= shortMA_.size()) {
-        return Signal::NONE;
-    }
-    
-    // Check for a bullish crossover (short MA crosses above long MA)
-    bool wasBelow = shortMA_[index - 1] < longMA_[index - 1];
-    bool isAbove = shortMA_[index] > longMA_[index];
-    
-    if (wasBelow && isAbove) {
-        return Signal::BUY;
+void MovingAverageStrategy::generateSignals(std::span<Signal> out) const {
+    // Crossover codes are the signals; none until the long MA is fully calculated
+    copySignalCodes(crossovers_, longPeriod_, out);
+}
+
+Signal MovingAverageStrategy::onBar(const OHLCV& bar) {
+    if (!stream_) {
+        stream_.emplace(StreamState{SimpleMovingAverage(shortPeriod_), SimpleMovingAverage(longPeriod_)});
     }
-    
-    // Check for a bearish crossover (short MA crosses below long MA)
-    bool wasAbove = shortMA_[index - 1] > longMA_[index - 1];
-    bool isBelow = shortMA_[index] < longMA_[index];
-    
-    if (wasAbove && isBelow) {
-        return Signal::SELL;
+    StreamState& state = *stream_;
+    double shortValue = state.shortMA.update(bar.close);
+    double longValue = state.longMA.update(bar.close);
+
+    // The same test as the crossovers kernel, and no signal before the long MA is ready
+    Signal signal = Signal::NONE;
+    if (state.bars >= longPeriod_) {
+        if (state.previousShort < state.previousLong && shortValue > longValue) {
+            signal = Signal::BUY;
+        } else if (state.previousShort > state.previousLong && shortValue < longValue) {
+            signal = Signal::SELL;
+        }
     }
-    
-    return Signal::NONE;
+    state.previousShort = shortValue;
+    state.previousLong = longValue;
+    state.bars++;
+    return signal;
+}
+
+void MovingAverageStrategy::resetStream() {
+    stream_.reset();
 }
 
 void MovingAverageStrategy::updateParameters(const std::map<std::string, double>& params) {
@@ -53,34 +63,24 @@ void MovingAverageStrategy::updateParameters(const std::map<std::string, double>
     }
     
     // Note: initialize() must be called again after updating parameters
+    resetStream();
 }
 
-void MovingAverageStrategy::calculateMovingAverages(const std::vector<OHLCV>& data) {
-    shortMA_.clear();
-    longMA_.clear();
-    
-    // Use closing prices for calculation
-    std::vector<double> closes;
-    for (const auto& candle : data) {
-        closes.push_back(candle.close);
-    }
+size_t MovingAverageStrategy::getMaxLookback() const {
+    return std::max(shortPeriod_, longPeriod_);
+}
 
-    // Calculate Simple Moving Average (SMA)
-    for (size_t i = 0; i < closes.size(); ++i) {
-        if (i + 1 >= shortPeriod_) {
-            double sum = std::accumulate(closes.end() - shortPeriod_, closes.end(), 0.0);
-            shortMA_.push_back(sum / shortPeriod_);
-        } else {
-            shortMA_.push_back(0.0); // Not enough data yet
-        }
-        
-        if (i + 1 >= longPeriod_) {
-            double sum = std::accumulate(closes.end() - longPeriod_, closes.end(), 0.0);
-            longMA_.push_back(sum / longPeriod_);
-        } else {
-            longMA_.push_back(0.0); // Not enough data yet
-        }
-    }
+void MovingAverageStrategy::calculateMovingAverages(std::span<const double> closes) {
+    // Running-sum SMAs: O(1) per bar regardless of the periods
+    auto sma = [&](size_t period) {
+        return getIndicator("SMA(close," + std::to_string(period) + ")", closes.size(),
+                            [&](std::span<double> out) { SimpleMovingAverage(period).compute(closes, out); });
+    };
+    shortMA_ = sma(shortPeriod_);
+    longMA_ = sma(longPeriod_);
+
+    crossovers_.resize(closes.size());
+    getIndicatorKernels().crossovers(shortMA_->data(), longMA_->data(), closes.size(), crossovers_.data());
 }
 
 } // namespace fingraph
\ No newline at end of file
@@ -1,34 +1,46 @@
 #include "fingraph/strategies/RSIStrategy.h"
+#include "fingraph/indicators/Kernels.h"
+#include "fingraph/indicators/Rsi.h"
 #include <vector>
-#include <numeric>
+#include <stdexcept>
+#include <string>
 
 namespace fingraph {
 
 RSIStrategy::RSIStrategy()
     : Strategy("RSI Mean Reversion"), period_(14), oversoldThreshold_(30.0), overboughtThreshold_(70.0) {}
 
-void RSIStrategy::initialize(const std::vector<OHLCV>& data) {
+void RSIStrategy::initialize(const MarketDataView& data) {
     if (data.size() < period_) {
         throw std::invalid_argument("Not enough data for RSI calculation.");
     }
     
-    calculateRSI(data);
+    calculateRSI(data.getCloses());
 }
 
-Signal RSIStrategy::generateSignal(size_t index) const {
-    if (index < period_ || index >= rsiValues_.size()) {
-        return Signal::NONE;
+void RSIStrategy::generateSignals(std::span<Signal> out) const {
+    // Threshold codes are the signals; none until the RSI is ready
+    copySignalCodes(signals_, period_, out);
+}
+
+Signal RSIStrategy::onBar(const OHLCV& bar) {
+    if (!stream_) {
+        stream_.emplace(StreamState{RelativeStrengthIndex(period_, RelativeStrengthIndex::Smoothing::Simple)});
     }
-    
-    double rsi = rsiValues_[index];
-    
-    if (rsi <= oversoldThreshold_) {
-        return Signal::BUY;
-    } else if (rsi >= overboughtThreshold_) {
-        return Signal::SELL;
+    StreamState& state = *stream_;
+    double rsi = state.rsi.update(bar.close);
+
+    // The same test as the thresholds kernel, and no signal before the RSI is ready
+    Signal signal = Signal::NONE;
+    if (state.bars >= period_) {
+        signal = rsi <= oversoldThreshold_ ? Signal::BUY : rsi >= overboughtThreshold_ ? Signal::SELL : Signal::NONE;
     }
-    
-    return Signal::NONE;
+    state.bars++;
+    return signal;
+}
+
+void RSIStrategy::resetStream() {
+    stream_.reset();
 }
 
 void RSIStrategy::updateParameters(const std::map<std::string, double>& params) {
@@ -48,33 +60,24 @@ void RSIStrategy::updateParameters(const std::map<std::string, double>& params)
     }
     
     // Note: initialize() must be called again after updating parameters
+    resetStream();
 }
 
-void RSIStrategy::calculateRSI(const std::vector<OHLCV>& data) {
-    rsiValues_.clear();
-    rsiValues_.resize(data.size(), 0.0);
-    
-    std::vector<double> gains(data.size(), 0.0);
-    std::vector<double> losses(data.size(), 0.0);
-    
-    // Calculate price changes
-    for (size_t i = 1; i < data.size(); ++i) {
-        double change = data[i].close - data[i-1].close;
-        if (change > 0) {
-            gains[i] = change;
-        } else {
-            losses[i] = -change;
-        }
-    }
-    
-    // Calculate initial averages
-    for (size_t i = period_; i < data.size(); ++i) {
-        double avgGain = std::accumulate(gains.begin() + i - period_ + 1, gains.begin() + i + 1, 0.0) / period_;
-        double avgLoss = std::accumulate(losses.begin() + i - period_ + 1, losses.begin() + i + 1, 0.0) / period_;
-        
-        double rs = (avgLoss == 0) ? 100.0 : avgGain / avgLoss;
-        rsiValues_[i] = 100.0 - (100.0 / (1.0 + rs));
-    }
+size_t RSIStrategy::getMaxLookback() const {
+    return period_;
+}
+
+void RSIStrategy::calculateRSI(std::span<const double> closes) {
+    // Plain means over the last `period` changes, so the lookback stays finite
+    rsiValues_ = getIndicator("RSI-simple(close," + std::to_string(period_) + ")", closes.size(),
+                              [&](std::span<double> out) {
+                                  RelativeStrengthIndex(period_, RelativeStrengthIndex::Smoothing::Simple)
+                                      .compute(closes, out);
+                              });
+
+    signals_.resize(closes.size());
+    getIndicatorKernels().thresholds(rsiValues_->data(), closes.size(), oversoldThreshold_, overboughtThreshold_,
+                                     signals_.data());
 }
 
 } // namespace fingraph
\ No newline at end of file
@@ -0,0 +1,577 @@
+// Micro-benchmarks for the hot kernels. Not part of the test suite: build the
+// bench_runner target and run it on an otherwise idle machine.
+#include "../include/fingraph/Backtest.h"
+#include "../include/fingraph/ParameterSweep.h"
+#include "../include/fingraph/WalkForward.h"
+#include "../include/fingraph/indicators/Kernels.h"
+#include "../include/fingraph/strategies/MovingAverageStrategy.h"
+#include "../include/fingraph/strategies/RSIStrategy.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace fingraph;
+
+namespace {
+
+// Best of several runs, in nanoseconds per element.
+double timePerElement(size_t elements, const std::function<void()>& run) {
+    run(); // Warm caches
+    double best = 1e300;
+    for (int trial = 0; trial < 7; ++trial) {
+        auto start = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < 20; ++rep) {
+            run();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, seconds * 1e9 / (20.0 * elements));
+    }
+    return best;
+}
+
+bool sameBits(const std::vector<double>& a, const std::vector<double>& b) {
+    return std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+double maxRelativeError(const std::vector<double>& actual, const std::vector<double>& expected) {
+    double worst = 0;
+    for (size_t i = 0; i < actual.size(); ++i) {
+        if (!std::isnan(expected[i])) {
+            worst = std::max(worst, std::abs(actual[i] - expected[i]) / std::max(1.0, std::abs(expected[i])));
+        }
+    }
+    return worst;
+}
+
+struct Row {
+    std::string kernel;
+    double scalarNs;
+    std::vector<double> flavourNs;
+    std::string check;
+};
+
+void printRow(const Row& row) {
+    std::printf("%-22s %8.3f", row.kernel.c_str(), row.scalarNs);
+    for (double ns : row.flavourNs) {
+        std::printf("   %8.3f (%5.2fx)", ns, row.scalarNs / ns);
+    }
+    std::printf("   %s\n", row.check.c_str());
+}
+
+void benchmarkIndicatorKernels() {
+    // Sized to stay in L2, so the kernels rather than memory bandwidth are measured
+    const size_t n = size_t(1) << 14;
+    std::vector<double> closes(n), other(n);
+    for (size_t i = 0; i < n; ++i) {
+        closes[i] = 100 + 10 * std::sin(i * 0.01) + (i % 7) * 0.1;
+        other[i] = 100 + 8 * std::cos(i * 0.013);
+    }
+
+    auto flavours = getSupportedIndicatorKernels();
+    const IndicatorKernels& scalar = *flavours.front();
+    std::printf("Indicator kernels, %zu elements, ns/element (speedup over scalar)\n", n);
+    std::printf("%-22s %8s", "kernel", "scalar");
+    for (size_t f = 1; f < flavours.size(); ++f) {
+        std::printf("   %18s", flavours[f]->name);
+    }
+    std::printf("   check\n");
+
+    std::vector<double> expected(n), actual(n), expected2(n), actual2(n);
+    std::vector<int8_t> expectedCodes(n), actualCodes(n);
+
+    // Each entry runs one kernel from the given table into the given outputs
+    struct Case {
+        const char* name;
+        bool exact;
+        std::function<void(const IndicatorKernels&, std::vector<double>&, std::vector<double>&, std::vector<int8_t>&)> run;
+    };
+    double sink = 0;
+    const Case cases[] = {
+        {"rollingSum(50)", false, [&](const IndicatorKernels& k, auto& out, auto&, auto&) {
+             k.rollingSum(closes.data(), n, 50, 1.0 / 50, out.data());
+         }},
+        {"priceChanges", true, [&](const IndicatorKernels& k, auto& out, auto& out2, auto&) {
+             k.priceChanges(closes.data(), n, out.data(), out2.data());
+         }},
+        {"relativeStrength", true, [&](const IndicatorKernels& k, auto& out, auto&, auto&) {
+             k.relativeStrength(closes.data(), other.data(), n, out.data());
+         }},
+        {"returns", true, [&](const IndicatorKernels& k, auto& out, auto&, auto&) {
+             k.returns(closes.data(), n, out.data());
+         }},
+        {"crossovers", true, [&](const IndicatorKernels& k, auto&, auto&, auto& codes) {
+             k.crossovers(closes.data(), other.data(), n, codes.data());
+         }},
+        {"thresholds", true, [&](const IndicatorKernels& k, auto&, auto&, auto& codes) {
+             k.thresholds(closes.data(), n, 95, 105, codes.data());
+         }},
+        {"sum", false, [&](const IndicatorKernels& k, auto& out, auto&, auto&) {
+             out[0] = k.sum(closes.data(), n);
+             sink += out[0];
+         }},
+        {"sumSquaredDeviations", false, [&](const IndicatorKernels& k, auto& out, auto&, auto&) {
+             out[0] = k.sumSquaredDeviations(closes.data(), n, 100);
+             sink += out[0];
+         }},
+    };
+
+    auto clear = [](std::vector<double>& out, std::vector<double>& out2, std::vector<int8_t>& codes) {
+        std::fill(out.begin(), out.end(), 0.0);
+        std::fill(out2.begin(), out2.end(), 0.0);
+        std::fill(codes.begin(), codes.end(), 0);
+    };
+    for (const Case& c : cases) {
+        clear(expected, expected2, expectedCodes);
+        Row row{c.name, timePerElement(n, [&] { c.run(scalar, expected, expected2, expectedCodes); }), {}, "ok"};
+        for (size_t f = 1; f < flavours.size(); ++f) {
+            clear(actual, actual2, actualCodes);
+            row.flavourNs.push_back(timePerElement(n, [&] { c.run(*flavours[f], actual, actual2, actualCodes); }));
+            bool ok = c.exact ? sameBits(actual, expected) && sameBits(actual2, expected2) && actualCodes == expectedCodes
+                              : maxRelativeError(actual, expected) < 1e-12;
+            if (!ok) {
+                row.check = std::string("MISMATCH in ") + flavours[f]->name;
+            }
+        }
+        printRow(row);
+    }
+    std::printf("(selected: %s)\n\n", getIndicatorKernels().name);
+    if (sink == 0.5) {
+        std::printf("\n"); // Keeps the reductions observable
+    }
+}
+
+// Forwards to a MovingAverageStrategy through the virtual interface only, so the
+// engine drives it with the generic loop rather than one specialized for its type.
+class ForwardingStrategy : public Strategy {
+public:
+    ForwardingStrategy() : Strategy("Forwarding Moving Average") {}
+    void initialize(const MarketDataView& data) override { inner_.initialize(data); }
+    Signal generateSignal(size_t index) const override { return inner_.generateSignal(index); }
+    void generateSignals(std::span<Signal> out) const override { inner_.generateSignals(out); }
+    void updateParameters(const std::map<std::string, double>& params) override { inner_.updateParameters(params); }
+    size_t getMaxLookback() const override { return inner_.getMaxLookback(); }
+
+private:
+    MovingAverageStrategy inner_;
+};
+
+// The simulation loop as it was before bulk signals: one virtual generateSignal()
+// call, position lookups and a price map per bar.
+BacktestResult perBarBacktest(const MarketDataView& data, Strategy& strategy, double initialCash) {
+    strategy.initialize(data);
+    Portfolio portfolio(initialCash);
+    BacktestResult result;
+    result.equityCurve.reserve(data.size());
+    auto closes = data.getCloses();
+    auto timestamps = data.getTimestamps();
+    for (size_t i = 0; i < data.size(); ++i) {
+        double close = closes[i];
+        auto timestamp = toTimePoint(timestamps[i]);
+        Signal signal = strategy.generateSignal(i);
+        if (signal == Signal::BUY && portfolio.getPosition("DEFAULT") == 0) {
+            double quantity = std::floor(portfolio.getCash() / close);
+            if (quantity > 0) {
+                portfolio.addTrade(Trade("DEFAULT", TradeType::BUY, quantity, close, timestamp));
+            }
+        } else if (signal == Signal::SELL && portfolio.getPosition("DEFAULT") > 0) {
+            portfolio.addTrade(Trade("DEFAULT", TradeType::SELL, portfolio.getPosition("DEFAULT"), close, timestamp));
+        }
+        std::map<std::string, double> currentPrices = { {"DEFAULT", close} };
+        result.equityCurve.emplace_back(timestamp, portfolio.getTotalValue(currentPrices));
+    }
+    result.symbols = portfolio.getSymbols();
+    result.trades = portfolio.takeTrades();
+    result.totalReturn = PerformanceMetrics::calculateTotalReturn(result.equityCurve);
+    result.maxDrawdown = PerformanceMetrics::calculateMaxDrawdown(result.equityCurve);
+    result.sharpeRatio = PerformanceMetrics::calculateSharpeRatio(result.equityCurve);
+    result.winRate = PerformanceMetrics::calculateWinRate(result.trades);
+    return result;
+}
+
+void benchmarkBacktestLoop() {
+    const size_t n = size_t(1) << 16;
+    ColumnBuffers columns;
+    for (size_t i = 0; i < n; ++i) {
+        double close = 100 + 10 * std::sin(i * 0.01) + (i % 7) * 0.1;
+        columns.append(1672531200 + int64_t(i) * 60, close, close + 1, close - 1, close, 1000);
+    }
+    MarketData md;
+    md.assign(std::move(columns));
+
+    const std::map<std::string, double> params = {{"shortPeriod", 10}, {"longPeriod", 30}};
+    MovingAverageStrategy strategy;
+    strategy.updateParameters(params);
+    BacktestEngine engine;
+    engine.registerStrategy(std::make_unique<ForwardingStrategy>());
+
+    BacktestResult before;
+    double perBarNs = timePerElement(n, [&] { before = perBarBacktest(md.getView(), strategy, 10000.0); });
+    std::printf("Moving average backtest, %zu bars, ns/bar (including indicators and metrics)\n", n);
+    std::printf("%-26s %8.3f\n", "per-bar virtual signals", perBarNs);
+    const std::pair<const char*, const char*> runs[] = {
+        {"bulk virtual signals", "Forwarding Moving Average"},
+        {"specialized loop", "Moving Average Crossover"},
+    };
+    for (const auto& [label, name] : runs) {
+        BacktestResult after;
+        double ns = timePerElement(n, [&] { after = engine.runBacktest(md.getView(), name, params, 10000.0); });
+        bool same = before.trades.size() == after.trades.size() && before.totalReturn == after.totalReturn &&
+                    before.equityCurve == after.equityCurve;
+        std::printf("%-26s %8.3f (%5.2fx)   %s\n", label, ns, perBarNs / ns, same ? "ok" : "MISMATCH");
+    }
+    // The specialized loop again, instantiated with the runtime cost model
+    std::map<std::string, double> costParams = params;
+    costParams["commissionPerTrade"] = 1;
+    costParams["spreadBps"] = 5;
+    costParams["impactCoefficient"] = 0.1;
+    BacktestResult costly;
+    double costNs = timePerElement(
+        n, [&] { costly = engine.runBacktest(md.getView(), "Moving Average Crossover", costParams, 10000.0); });
+    std::printf("%-26s %8.3f (%5.2fx)   %zu trades, costs %.2f\n", "specialized, with costs", costNs,
+                perBarNs / costNs, costly.trades.size(), costly.totalCosts);
+    std::printf("\n");
+}
+
+// Per-call latency percentiles of `call` over `calls` calls, in nanoseconds. Each
+// sample includes one steady_clock read, whose own cost is reported alongside.
+struct Latency {
+    double p50;
+    double p99;
+    double max;
+};
+
+template <typename Call>
+Latency measureLatency(size_t calls, Call&& call) {
+    std::vector<double> samples(calls);
+    for (size_t i = 0; i < calls; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        call(i);
+        samples[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::sort(samples.begin(), samples.end());
+    return {samples[calls / 2], samples[calls * 99 / 100], samples.back()};
+}
+
+void benchmarkLiveLatency() {
+    const size_t n = size_t(1) << 16;
+    std::vector<OHLCV> bars(n);
+    for (size_t i = 0; i < n; ++i) {
+        double close = 100 + 10 * std::sin(i * 0.01) + (i % 7) * 0.1;
+        bars[i] = {toTimePoint(1672531200 + int64_t(i) * 60), close, close + 1, close - 1, close, 1000};
+    }
+
+    std::printf("Live onBar() latency, %zu bars, ns per bar\n", n);
+    std::printf("%-26s %8s %8s %8s\n", "strategy", "p50", "p99", "max");
+    auto print = [](const char* label, const Latency& latency) {
+        std::printf("%-26s %8.1f %8.1f %8.1f\n", label, latency.p50, latency.p99, latency.max);
+    };
+    volatile int sink = 0;
+    print("(clock read only)", measureLatency(n, [&](size_t) { sink = sink + 1; }));
+
+    MovingAverageStrategy ma;
+    ma.updateParameters({{"shortPeriod", 10}, {"longPeriod", 30}});
+    print("Moving Average Crossover", measureLatency(n, [&](size_t i) { sink = sink + int(ma.onBar(bars[i])); }));
+    RSIStrategy rsi;
+    rsi.updateParameters({{"period", 14}});
+    print("RSI Mean Reversion", measureLatency(n, [&](size_t i) { sink = sink + int(rsi.onBar(bars[i])); }));
+    std::printf("\n");
+}
+
+void benchmarkPortfolioValuation() {
+    // 500 held symbols; each bar 25 of them get a new price
+    const size_t symbols = 500, changed = 25, bars = 200;
+    Portfolio dense(1e9), keyed(1e9);
+    std::vector<std::string> names;
+    std::vector<SymbolId> ids;
+    for (size_t i = 0; i < symbols; ++i) {
+        names.push_back("SYM" + std::to_string(i));
+        ids.push_back(dense.internSymbol(names.back()));
+        Trade trade(names.back(), TradeType::BUY, 100, 50.0 + i, toTimePoint(0));
+        dense.addTrade(trade);
+        keyed.addTrade(trade);
+    }
+    std::vector<double> lastPrices(symbols);
+    for (size_t i = 0; i < symbols; ++i) {
+        lastPrices[i] = 50.0 + i;
+    }
+    std::vector<SymbolId> changedIds(changed);
+    std::vector<double> changedPrices(changed);
+
+    double sink = 0;
+    auto priceAt = [](size_t bar, size_t symbol) { return 50.0 + symbol + std::sin(bar * 0.1 + symbol); };
+    // Per bar: a price map for every symbol, then a walk over the positions
+    double keyedNs = timePerElement(bars, [&] {
+        for (size_t bar = 0; bar < bars; ++bar) {
+            for (size_t k = 0; k < changed; ++k) {
+                size_t symbol = (bar * changed + k) % symbols;
+                lastPrices[symbol] = priceAt(bar, symbol);
+            }
+            std::map<std::string, double> currentPrices;
+            for (size_t i = 0; i < symbols; ++i) {
+                currentPrices[names[i]] = lastPrices[i];
+            }
+            sink += keyed.getTotalValue(currentPrices);
+        }
+    });
+    // Per bar: the changed prices only, and the running value
+    double denseNs = timePerElement(bars, [&] {
+        for (size_t bar = 0; bar < bars; ++bar) {
+            for (size_t k = 0; k < changed; ++k) {
+                size_t symbol = (bar * changed + k) % symbols;
+                changedIds[k] = ids[symbol];
+                changedPrices[k] = priceAt(bar, symbol);
+            }
+            dense.updatePrices(changedIds, changedPrices);
+            sink += dense.getTotalValue();
+        }
+    });
+    std::printf("Portfolio valuation, %zu held symbols, %zu price changes per bar, ns/bar\n", symbols, changed);
+    std::printf("%-26s %10.1f\n", "string-keyed price map", keyedNs);
+    std::printf("%-26s %10.1f (%5.1fx)\n\n", "dense ids, incremental", denseNs, keyedNs / denseNs);
+    if (sink == 0.5) {
+        std::printf("\n");
+    }
+}
+
+} // namespace
+
+void benchmarkTradeLog() {
+    // A strategy that trades on most bars: record every trade, then hand the log to the result
+    const size_t trades = 100000;
+    const std::string symbol = "DEFAULT";
+    size_t sink = 0;
+    // As before: a Trade with its own symbol string per trade, copied out of the portfolio
+    double stringNs = timePerElement(trades, [&] {
+        std::vector<Trade> log;
+        for (size_t i = 0; i < trades; ++i) {
+            log.emplace_back(symbol, i % 2 ? TradeType::SELL : TradeType::BUY, 100, 50.0 + i % 7, toTimePoint(i));
+        }
+        std::vector<Trade> result = log;
+        sink += result.size();
+    });
+    double recordNs = timePerElement(trades, [&] {
+        TradeLog log;
+        for (size_t i = 0; i < trades; ++i) {
+            log.push_back(TradeRecord{toTimePoint(i), 100, 50.0 + i % 7, 0, i % 2 ? TradeType::SELL : TradeType::BUY});
+        }
+        TradeLog result = std::move(log);
+        sink += result.size();
+    });
+    std::printf("Trade logging, %zu trades, ns/trade (record + hand off)\n", trades);
+    std::printf("%-26s %10.1f (%zu bytes each)\n", "Trade with symbol string", stringNs, sizeof(Trade));
+    std::printf("%-26s %10.1f (%zu bytes each, %5.1fx)\n\n", "TradeRecord in TradeLog", recordNs, sizeof(TradeRecord),
+                stringNs / recordNs);
+    if (sink == 1) {
+        std::printf("\n");
+    }
+}
+
+void benchmarkOrderBook() {
+    // 10000 resting limits, stops and trailing stops around the price; every fill is
+    // replaced by a new order, so the book stays full
+    // A mean-reverting random walk; every timed pass moves on to new bars
+    const size_t resting = 10000, bars = 500, passes = 141;
+    std::vector<double> opens(bars * passes), highs(bars * passes), lows(bars * passes);
+    std::mt19937 rng(11);
+    std::normal_distribution<double> step(0.0, 0.6);
+    double close = 100;
+    for (size_t i = 0; i < opens.size(); ++i) {
+        opens[i] = close;
+        close += step(rng) + (100 - close) * 0.01;
+        highs[i] = std::max(opens[i], close) + std::abs(step(rng)) * 0.5;
+        lows[i] = std::min(opens[i], close) - std::abs(step(rng)) * 0.5;
+    }
+    // Orders rest on the untriggered side of `reference`, 0.5 to 12.5 away
+    size_t next = 0;
+    auto makeOrder = [&next](double reference) {
+        size_t k = next++;
+        TradeType side = k % 2 ? TradeType::SELL : TradeType::BUY;
+        OrderType type = static_cast<OrderType>(1 + k % 3);
+        bool fallsTo = type == OrderType::LIMIT ? side == TradeType::BUY : side == TradeType::SELL;
+        double distance = 0.5 + std::fmod(k * 7.31, 12.0);
+        double price = type == OrderType::TRAILING_STOP ? reference : reference + (fallsTo ? -distance : distance);
+        return Order{0, side, type, 1, price, distance};
+    };
+
+    // A scan over every resting order per bar
+    struct Resting {
+        Order order;
+        double extreme;
+    };
+    std::vector<Resting> scanned;
+    for (size_t i = 0; i < resting; ++i) {
+        Order order = makeOrder(100);
+        scanned.push_back({order, order.price});
+    }
+    size_t sink = 0;
+    size_t bar = 0;
+    double scanNs = timePerElement(bars, [&] {
+        for (size_t end = bar + bars; bar < end; ++bar) {
+            size_t i = bar % opens.size();
+            for (Resting& r : scanned) {
+                const Order& o = r.order;
+                bool buy = o.side == TradeType::BUY;
+                double trigger = o.type != OrderType::TRAILING_STOP ? o.price : (buy ? r.extreme + o.trail : r.extreme - o.trail);
+                bool fallsTo = o.type == OrderType::LIMIT ? buy : !buy;
+                if (fallsTo ? lows[i] <= trigger : highs[i] >= trigger) {
+                    ++sink;
+                    r.order = makeOrder(opens[i]);
+                    r.extreme = r.order.price;
+                } else {
+                    r.extreme = buy ? std::min(r.extreme, lows[i]) : std::max(r.extreme, highs[i]);
+                }
+            }
+        }
+    });
+
+    OrderBook book;
+    next = 0;
+    for (size_t i = 0; i < resting; ++i) {
+        book.place(makeOrder(100));
+    }
+    std::vector<Fill> fills;
+    size_t filled = 0;
+    bar = 0;
+    double bookNs = timePerElement(bars, [&] {
+        for (size_t end = bar + bars; bar < end; ++bar) {
+            size_t i = bar % opens.size();
+            fills.clear();
+            book.processBar(0, opens[i], highs[i], lows[i], fills);
+            for (size_t k = 0; k < fills.size(); ++k) {
+                book.place(makeOrder(opens[i]));
+            }
+            filled += fills.size();
+        }
+    });
+    std::printf("Order book, %zu resting orders, ns/bar (%.1f fills per bar)\n", resting,
+                double(filled) / bar);
+    std::printf("%-26s %10.1f\n", "scan every order", scanNs);
+    std::printf("%-26s %10.1f (%5.1fx)\n\n", "trigger-price heaps", bookNs, scanNs / bookNs);
+    if (sink == 1) {
+        std::printf("\n");
+    }
+}
+
+// 100k moving average crossovers over ten years of daily bars: as one sweep, and
+// as separate runs that each start from a fresh engine without shared indicators.
+void benchmarkParameterSweep() {
+    const size_t bars = 2520;
+    ColumnBuffers columns;
+    std::mt19937 rng(5);
+    std::normal_distribution<double> step(0.0005, 0.015);
+    double close = 100;
+    for (size_t i = 0; i < bars; ++i) {
+        double open = close;
+        close *= std::exp(step(rng));
+        columns.append(1262304000 + int64_t(i) * 86400, open, std::max(open, close) * 1.004,
+                       std::min(open, close) * 0.996, close, 1e6);
+    }
+    MarketData md;
+    md.assign(std::move(columns));
+    ParameterGrid grid({ParameterAxis::range("shortPeriod", 1, 100, 1), ParameterAxis::range("longPeriod", 10, 1009, 1)});
+
+    const size_t separateRuns = 500;
+    std::map<std::string, double> params;
+    double sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t row = 0; row < separateRuns; ++row) {
+        BacktestEngine engine;
+        grid.getPoint(row * (grid.size() / separateRuns), params);
+        sink += engine.runBacktest(md.getView(), "Moving Average Crossover", params, 10000.0).totalReturn;
+    }
+    double separateUs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e6 / separateRuns;
+
+    IndicatorCache cache;
+    BacktestEngine engine;
+    engine.setIndicatorCache(&cache);
+    ParameterSweep sweep(engine);
+    start = std::chrono::steady_clock::now();
+    SweepResult result = sweep.run(md.getView(), "Moving Average Crossover", grid, 10000.0, {}, "daily");
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("Parameter sweep, %zu points over %zu daily bars, %zu threads\n", grid.size(), bars,
+                ThreadPool::shared().size());
+    std::printf("%-26s %10.1f us/point (%.0f s for the grid)\n", "separate runs", separateUs,
+                separateUs * grid.size() / 1e6);
+    std::printf("%-26s %10.1f us/point (%.2f s, %.0fx; %zu failed, best Sharpe %.2f)\n", "sweep",
+                seconds * 1e6 / grid.size(), seconds, separateUs * grid.size() / 1e6 / seconds, result.failed,
+                result.top.empty() ? 0.0 : result.table.sharpeRatio[result.top.front()]);
+
+    // The searches, by the bars they ran and where their best point ranks in the grid
+    const std::vector<double>& sharpe = result.table.sharpeRatio;
+    auto report = [&](const char* name, const SweepResult& searched, double searchSeconds) {
+        size_t best = searched.getGridIndex(searched.top.front());
+        size_t rank = std::count_if(sharpe.begin(), sharpe.end(), [&](double s) { return s > sharpe[best]; });
+        std::printf("%-26s %10.2f s, %5.1f%% of the bars, best point ranks %zu of %zu\n", name, searchSeconds,
+                    100.0 * searched.barsExecuted / result.barsExecuted, rank + 1, grid.size());
+    };
+    start = std::chrono::steady_clock::now();
+    SweepResult halved = sweep.runSuccessiveHalving(md.getView(), "Moving Average Crossover", grid, 10000.0, {}, {},
+                                                    "daily");
+    report("successive halving", halved, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    start = std::chrono::steady_clock::now();
+    SweepResult evolved = sweep.runGenetic(md.getView(), "Moving Average Crossover", grid, 10000.0, {}, {}, "daily");
+    report("genetic", evolved, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    std::printf("\n");
+    if (sink == 1) {
+        std::printf("\n");
+    }
+}
+
+// Two years in sample, a quarter out of sample, over ten years of daily bars.
+void benchmarkWalkForward() {
+    const size_t bars = 2520;
+    ColumnBuffers columns;
+    std::mt19937 rng(9);
+    std::normal_distribution<double> step(0.0005, 0.015);
+    double close = 100;
+    for (size_t i = 0; i < bars; ++i) {
+        double open = close;
+        close *= std::exp(step(rng));
+        columns.append(1262304000 + int64_t(i) * 86400, open, std::max(open, close) * 1.004,
+                       std::min(open, close) * 0.996, close, 1e6);
+    }
+    MarketData md;
+    md.assign(std::move(columns));
+    ParameterGrid grid({ParameterAxis::range("shortPeriod", 2, 40, 2), ParameterAxis::range("longPeriod", 20, 400, 20)});
+
+    IndicatorCache cache;
+    BacktestEngine engine;
+    engine.setIndicatorCache(&cache);
+    WalkForward walkForward(engine);
+    WalkForwardOptions options;
+    options.inSampleBars = 504;
+    options.outOfSampleBars = 63;
+    std::printf("Walk-forward, %zu-point grid over %zu daily bars\n", grid.size(), bars);
+    for (bool anchored : {false, true}) {
+        options.anchored = anchored;
+        auto start = std::chrono::steady_clock::now();
+        WalkForwardResult result = walkForward.run(md.getView(), "Moving Average Crossover", grid, 10000.0,
+                                                   options, "daily");
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-26s %10.2f s, %zu folds, %.1fM bars, out-of-sample Sharpe %.2f\n",
+                    anchored ? "anchored" : "rolling", seconds, result.folds.size(), result.barsExecuted / 1e6,
+                    result.outOfSample.sharpeRatio);
+    }
+    std::printf("\n");
+}
+
+int main() {
+    benchmarkIndicatorKernels();
+    benchmarkBacktestLoop();
+    benchmarkLiveLatency();
+    benchmarkPortfolioValuation();
+    benchmarkTradeLog();
+    benchmarkOrderBook();
+    benchmarkParameterSweep();
+    benchmarkWalkForward();
+    return 0;
+}
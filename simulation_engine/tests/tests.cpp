@@ -1,14 +1,1510 @@
 #include "../include/fingraph/Backtest.h"
+#include "../include/fingraph/ColumnarCache.h"
+#include "../include/fingraph/CostModel.h"
+#include "../include/fingraph/DatabaseService.h"
+#include "../include/fingraph/DatasetCache.h"
+#include "../include/fingraph/GorillaCodec.h"
+#include "../include/fingraph/IndicatorCache.h"
+#include "../include/fingraph/CsvParser.h"
 #include "../include/fingraph/MarketData.h"
+#include "../include/fingraph/MarketDataStream.h"
+#include "../include/fingraph/MarketPanel.h"
+#include "../include/fingraph/OrderBook.h"
+#include "../include/fingraph/ParameterSweep.h"
 #include "../include/fingraph/PerformanceMetrics.h"
 #include "../include/fingraph/Portfolio.h"
 #include "../include/fingraph/Strategy.h"
+#include "../include/fingraph/SymbolTable.h"
+#include "../include/fingraph/ThreadPool.h"
 #include "../include/fingraph/Trade.h"
+#include "../include/fingraph/TradeLog.h"
+#include "../include/fingraph/WalkForward.h"
+#include "../include/fingraph/indicators/Kernels.h"
+#include "../include/fingraph/indicators/MovingAverages.h"
+#include "../include/fingraph/indicators/RollingExtremum.h"
+#include "../include/fingraph/indicators/Rsi.h"
+#include "../include/fingraph/indicators/Volatility.h"
+#include "../include/fingraph/strategies/MovingAverageStrategy.h"
+#include "../include/fingraph/strategies/RSIStrategy.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <fstream>
 #include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+
+using namespace fingraph;
+
+static int g_failures = 0;
+
+#define CHECK(cond)                                                              \
+    do {                                                                         \
+        if (!(cond)) {                                                           \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #cond \
+                      << std::endl;                                              \
+            ++g_failures;                                                        \
+        }                                                                        \
+    } while (0)
+
+static int64_t epochSeconds(const OHLCV& bar) {
+    return std::chrono::duration_cast<std::chrono::seconds>(bar.timestamp.time_since_epoch()).count();
+}
+
+static std::string writeTempFile(const std::string& name, const std::string& contents) {
+    std::string path = "/tmp/fingraph_test_" + name;
+    std::ofstream out(path, std::ios::binary);
+    out << contents;
+    return path;
+}
+
+static void testParseTimestamp() {
+    int64_t t = 0;
+    CHECK(CsvParser::parseTimestamp("1970-01-01", t) && t == 0);
+    CHECK(CsvParser::parseTimestamp("2023-01-01", t) && t == 1672531200);
+    CHECK(CsvParser::parseTimestamp("2024-02-29 09:30:00", t) && t == 1709199000);
+    CHECK(CsvParser::parseTimestamp("2024-02-29T09:30", t) && t == 1709199000);
+    CHECK(CsvParser::parseTimestamp("2024-02-29T09:30:15.250Z", t) && t == 1709199015);
+    CHECK(!CsvParser::parseTimestamp("2023-13-01", t));
+    CHECK(!CsvParser::parseTimestamp("2023/01/01", t));
+    CHECK(!CsvParser::parseTimestamp("2023-01-01 9:30", t));
+    CHECK(!CsvParser::parseTimestamp("", t));
+}
+
+static void testLoadFromCSV() {
+    std::string path = writeTempFile("load.csv",
+        "timestamp,open,high,low,close,volume\r\n"
+        "2023-01-02,100.5,101,99.25,100.75,12000\r\n"
+        "2023-01-03,100.75,102.5,100,+102,1.5e4\r\n"
+        "\r\n"
+        "2023-01-04,102,103,101,102.5,15000.0\r\n"
+        "2023-01-05,102.5,104,102,103.5\n"
+        "2023-01-06,103.5,105,103,104.5,18000,extra");
+
+    MarketData md;
+    CHECK(md.loadFromCSV(path, CsvLoadOptions{.useBinaryCache = false}));
+    const auto& data = md.getData();
+    CHECK(data.size() == 3);
+    if (data.size() == 3) {
+        CHECK(epochSeconds(data[0]) == 1672617600);
+        CHECK(data[0].open == 100.5 && data[0].high == 101 && data[0].low == 99.25);
+        CHECK(data[0].close == 100.75 && data[0].volume == 12000);
+        CHECK(data[1].close == 102.5 && data[1].volume == 15000);
+        CHECK(data[2].volume == 18000);
+    }
+
+    const LoadReport& report = md.getLoadReport();
+    CHECK(report.rowsLoaded == 3);
+    CHECK(report.rowsRejected == 2);
+    CHECK(report.errors.size() == 2 && report.errors[0].line == 3 && report.errors[1].line == 6);
+    std::remove(path.c_str());
+}
+
+static void testParallelParse() {
+    // Blank lines, CRLF, malformed rows and a final line without a newline
+    std::string text;
+    for (int i = 0; i < 500; ++i) {
+        text += "2023-01-" + std::to_string(10 + i % 18) + " 09:" + std::to_string(10 + i % 50) +
+                ":00," + std::to_string(100 + i) + ".25,101,99,100.5," + std::to_string(1000 + i);
+        text += (i % 7 == 0) ? "\r\n" : "\n";
+        if (i % 53 == 0) text += "\n";
+        if (i % 97 == 0) text += "garbage," + std::to_string(i) + "\n";
+    }
+    text += "2023-02-01,1,2,0.5,1.5,10";
+
+    ColumnBuffers serial;
+    LoadReport serialReport;
+    CsvParser::parseRows(text, 2, serial, serialReport);
+
+    ThreadPool pool(3);
+    for (size_t chunks : {1, 2, 3, 7, 64, 1000}) {
+        ColumnBuffers parallel;
+        LoadReport parallelReport;
+        CsvParser::parseRowsParallel(text, 2, parallel, parallelReport, pool, chunks);
+        CHECK(parallel.size() == serial.size());
+        CHECK(parallel.timestamps == serial.timestamps && parallel.close == serial.close);
+        CHECK(parallel.open == serial.open && parallel.volume == serial.volume);
+        CHECK(parallelReport.rowsRejected == serialReport.rowsRejected);
+        CHECK(parallelReport.errors.size() == serialReport.errors.size());
+        for (size_t i = 0; i < parallelReport.errors.size() && i < serialReport.errors.size(); ++i) {
+            CHECK(parallelReport.errors[i].line == serialReport.errors[i].line);
+            CHECK(parallelReport.errors[i].message == serialReport.errors[i].message);
+        }
+    }
+
+    // loadFromCSV takes the parallel path when asked to, with the same result
+    std::string path = writeTempFile("parallel.csv", "timestamp,open,high,low,close,volume\n" + text);
+    MarketData serialLoad, parallelLoad;
+    CHECK(serialLoad.loadFromCSV(path, CsvLoadOptions{.useBinaryCache = false, .parseThreads = 1}));
+    CHECK(parallelLoad.loadFromCSV(path, CsvLoadOptions{.useBinaryCache = false, .parseThreads = 4,
+                                                        .parallelMinBytes = 0}));
+    CHECK(serialLoad.size() == serial.size() && parallelLoad.size() == serial.size());
+    CHECK(std::equal(parallelLoad.getCloses().begin(), parallelLoad.getCloses().end(),
+                     serialLoad.getCloses().begin(), serialLoad.getCloses().end()));
+    CHECK(parallelLoad.getLoadReport().rowsRejected == serialLoad.getLoadReport().rowsRejected);
+    std::remove(path.c_str());
+}
+
+// Builds a series that falls for `down` bars and then rises for `up` bars.
+static MarketData makeVShapedSeries(size_t down, size_t up) {
+    ColumnBuffers columns;
+    double price = 100.0;
+    for (size_t i = 0; i < down + up; ++i) {
+        price += (i < down) ? -1.0 : 1.0;
+        columns.append(1672531200 + static_cast<int64_t>(i) * 86400, price, price + 0.5, price - 0.5, price, 1000 + i);
+    }
+    MarketData md;
+    md.assign(std::move(columns));
+    return md;
+}
+
+static void testColumnarStorage() {
+    MarketData md = makeVShapedSeries(20, 20);
+    CHECK(md.size() == 40);
+    CHECK(reinterpret_cast<uintptr_t>(md.getCloses().data()) % kCacheLineSize == 0);
+    CHECK(reinterpret_cast<uintptr_t>(md.getTimestamps().data()) % kCacheLineSize == 0);
+
+    // The AoS compatibility view matches the columns row for row
+    const auto& rows = md.getData();
+    CHECK(rows.size() == md.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        CHECK(epochSeconds(rows[i]) == md.getTimestamps()[i]);
+        CHECK(rows[i].close == md.getCloses()[i] && rows[i].volume == md.getVolumes()[i]);
+    }
+
+    // Copies share the same immutable columns
+    MarketData copy = md;
+    CHECK(copy.getCloses().data() == md.getCloses().data());
+}
+
+static void testRangeViews() {
+    MarketData md = makeVShapedSeries(20, 20); // Daily bars from 2023-01-01
+    const int64_t day = 86400;
+    const int64_t first = md.getTimestamps()[0];
+
+    // Inclusive on both ends; bounds between bars round inwards
+    MarketDataView range = md.getViewInRange(toTimePoint(first + 5 * day), toTimePoint(first + 9 * day));
+    CHECK(range.size() == 5);
+    CHECK(range.getCloses().data() == md.getCloses().data() + 5);
+    range = md.getViewInRange(toTimePoint(first + 5 * day - 1), toTimePoint(first + 9 * day + 1));
+    CHECK(range.size() == 5 && range.getTimestamps()[0] == first + 5 * day);
+
+    // Out of range and inverted windows are empty rather than errors
+    CHECK(md.getViewInRange(toTimePoint(first + 100 * day), toTimePoint(first + 200 * day)).empty());
+    CHECK(md.getViewInRange(toTimePoint(first + 9 * day), toTimePoint(first + 5 * day)).empty());
+    CHECK(md.getViewInRange(toTimePoint(0), toTimePoint(first + 100 * day)).size() == md.size());
+
+    // Irregular spacing and duplicate timestamps: results match std::lower_bound
+    ColumnBuffers columns;
+    const int64_t stamps[] = {10, 11, 12, 12, 12, 500, 501, 10000, 10000, 20000};
+    for (int64_t ts : stamps) {
+        columns.append(ts, 1, 1, 1, 1, 1);
+    }
+    MarketData irregular;
+    irregular.assign(std::move(columns));
+    auto ts = irregular.getTimestamps();
+    for (int64_t target = 0; target <= 20001; target += (target < 600 ? 1 : 97)) {
+        size_t expectedLower = std::lower_bound(ts.begin(), ts.end(), target) - ts.begin();
+        size_t expectedUpper = std::upper_bound(ts.begin(), ts.end(), target) - ts.begin();
+        CHECK(irregular.getView().lowerBound(target) == expectedLower);
+        CHECK(irregular.getView().upperBound(target) == expectedUpper);
+    }
+
+    // The copying API returns the same bars
+    auto rows = md.getDataInRange(toTimePoint(first + 5 * day), toTimePoint(first + 9 * day));
+    CHECK(rows.size() == 5 && epochSeconds(rows.front()) == first + 5 * day);
+}
+
+static void testMarketPanel() {
+    // AAA trades at t = 10, 20, 30, 40; BBB starts later and skips 30
+    auto makeSeries = [](std::initializer_list<std::pair<int64_t, double>> bars) {
+        ColumnBuffers columns;
+        for (auto [ts, close] : bars) {
+            columns.append(ts, close, close, close, close, static_cast<uint64_t>(close * 10));
+        }
+        auto data = std::make_shared<MarketData>();
+        data->assign(std::move(columns));
+        return std::shared_ptr<const MarketData>(data);
+    };
+    MarketPanel panel;
+    panel.assign({"AAA", "BBB"}, {makeSeries({{10, 1}, {20, 2}, {30, 3}, {40, 4}}),
+                                  makeSeries({{15, 50}, {20, 60}, {40, 70}, {50, 80}})});
+
+    const int64_t axis[] = {10, 15, 20, 30, 40, 50};
+    CHECK(panel.size() == 6 && panel.getSymbolCount() == 2);
+    CHECK(std::equal(panel.getTimestamps().begin(), panel.getTimestamps().end(), std::begin(axis), std::end(axis)));
+    CHECK(panel.findSymbol("BBB") == 1 && panel.findSymbol("CCC") == MarketPanel::npos);
+
+    const uint8_t bbbPresent[] = {0, 1, 1, 0, 1, 1};
+    auto present = panel.getPresentMask(1);
+    CHECK(std::equal(present.begin(), present.end(), std::begin(bbbPresent), std::end(bbbPresent)));
+    CHECK(panel.getFillIndex(1)[0] == MarketPanel::kNoBar && panel.getFillIndex(1)[3] == 1);
+
+    // Forward-filled prices, NaN before the first bar; rows are contiguous per symbol
+    auto aaa = panel.getCloses(0);
+    auto bbb = panel.getCloses(1);
+    CHECK(aaa[1] == 1 && aaa[5] == 4);
+    CHECK(std::isnan(bbb[0]) && bbb[3] == 60 && bbb[5] == 80);
+    CHECK(bbb.data() == aaa.data() + panel.size());
+    CHECK(panel.getVolumes(1)[3] == 0 && panel.getVolumes(1)[4] == 700);
+
+    // Parallel file loading gives the same alignment
+    std::string a = writeTempFile("panel_a.csv", "timestamp,open,high,low,close,volume\n"
+                                  "2023-01-02,1,1,1,1,10\n2023-01-04,2,2,2,2,20\n");
+    std::string b = writeTempFile("panel_b.csv", "timestamp,open,high,low,close,volume\n"
+                                  "2023-01-03,5,5,5,5,50\n2023-01-04,6,6,6,6,60\n");
+    MarketPanel loaded;
+    CHECK(loaded.loadFromCSV({"A", "B"}, {a, b}, CsvLoadOptions{.useBinaryCache = false}));
+    CHECK(loaded.size() == 3 && loaded.getCloses(0)[1] == 1 && std::isnan(loaded.getCloses(1)[0]));
+    CHECK(!loaded.loadFromCSV({"A", "X"}, {a, "/nonexistent/panel.csv"}));
+    std::remove(a.c_str());
+    std::remove(b.c_str());
+}
+
+static void testBinaryCache() {
+    std::string path = writeTempFile("cache.csv",
+        "timestamp,open,high,low,close,volume\n"
+        "2023-01-02 09:30:00,100.5,101,99.25,100.75,12000\n"
+        "2023-01-02 09:31:00,100.75,102.5,100,102,15000\n"
+        "bad row\n"
+        "2023-01-02 09:32:00,102,103,101,102.5,15000\n");
+    std::string cachePath = ColumnarCache::cachePathFor(path);
+    std::remove(cachePath.c_str());
+
+    MarketData parsed;
+    CHECK(parsed.loadFromCSV(path));
+    CHECK(std::ifstream(cachePath).good());
+
+    // The second load maps the cache and reproduces the parsed columns exactly
+    MarketData cached;
+    CHECK(cached.loadFromCSV(path));
+    CHECK(cached.size() == 3 && parsed.size() == 3);
+    CHECK(cached.getCloses().data() != parsed.getCloses().data());
+    CHECK(reinterpret_cast<uintptr_t>(cached.getVolumes().data()) % kCacheLineSize == 0);
+    for (size_t i = 0; i < cached.size() && i < parsed.size(); ++i) {
+        CHECK(cached.getTimestamps()[i] == parsed.getTimestamps()[i]);
+        CHECK(cached.getOpens()[i] == parsed.getOpens()[i] && cached.getLows()[i] == parsed.getLows()[i]);
+        CHECK(cached.getHighs()[i] == parsed.getHighs()[i] && cached.getCloses()[i] == parsed.getCloses()[i]);
+        CHECK(cached.getVolumes()[i] == parsed.getVolumes()[i]);
+    }
+    CHECK(cached.getLoadReport().rowsRejected == 1);
+
+    // Changing the source invalidates the cache
+    writeTempFile("cache.csv",
+        "timestamp,open,high,low,close,volume\n"
+        "2023-01-02 09:30:00,100.5,101,99.25,100.75,12000\n");
+    MarketData reparsed;
+    CHECK(reparsed.loadFromCSV(path));
+    CHECK(reparsed.size() == 1);
+
+    std::remove(path.c_str());
+    std::remove(cachePath.c_str());
+}
+
+static void testGorillaCodec() {
+    // Timestamps: regular runs, weekend-sized gaps, out-of-order and extreme values
+    std::vector<int64_t> timestamps;
+    for (int64_t i = 0; i < 300; ++i) {
+        timestamps.push_back(1672531200 + i * 86400 + (i % 5 == 0 ? 2 * 86400 : 0));
+    }
+    timestamps.insert(timestamps.end(), {5, -7, INT64_MIN, INT64_MAX, 0, 0, 1});
+    std::vector<uint8_t> encoded;
+    GorillaCodec::encodeTimestamps(timestamps, encoded);
+    std::vector<int64_t> decodedTimestamps(timestamps.size());
+    CHECK(GorillaCodec::decodeTimestamps(encoded.data(), encoded.size(), timestamps.size(), decodedTimestamps.data()));
+    CHECK(decodedTimestamps == timestamps);
+    CHECK(!GorillaCodec::decodeTimestamps(encoded.data(), encoded.size() / 2, timestamps.size(), decodedTimestamps.data()));
+
+    // Doubles, bit for bit: exact decimals take the scaled path, anything else XOR
+    auto roundTrips = [](const std::vector<double>& values, size_t* encodedSize) {
+        std::vector<uint8_t> bytes;
+        GorillaCodec::encodeDoubles(values, bytes);
+        std::vector<double> decoded(values.size());
+        bool ok = GorillaCodec::decodeDoubles(bytes.data(), bytes.size(), values.size(), decoded.data()) &&
+                  std::memcmp(decoded.data(), values.data(), values.size() * sizeof(double)) == 0;
+        if (encodedSize) *encodedSize = bytes.size();
+        return ok;
+    };
+    std::vector<double> prices;
+    for (int i = 0; i < 1000; ++i) {
+        prices.push_back((10025 + i % 37 - (i % 11) * 5) / 100.0); // As parsed from "100.25"
+    }
+    size_t pricesSize = 0;
+    CHECK(roundTrips(prices, &pricesSize));
+    CHECK(pricesSize * 4 < prices.size() * sizeof(double));
+    std::vector<double> awkward = {0.1 + 0.2, -0.0, 0.0, std::numeric_limits<double>::quiet_NaN(),
+                                   std::numeric_limits<double>::infinity(), 1e300, -1e-300, 42.0, 42.0};
+    CHECK(roundTrips(awkward, nullptr));
+    std::vector<double> noisy;
+    for (int i = 0; i < 500; ++i) {
+        noisy.push_back(std::sin(i * 0.37) * 1234.5678);
+    }
+    CHECK(roundTrips(noisy, nullptr));
+
+    std::vector<uint64_t> volumes = {0, 1, 127, 128, 15000, UINT64_MAX, 42};
+    encoded.clear();
+    GorillaCodec::encodeVarints(volumes, encoded);
+    std::vector<uint64_t> decodedVolumes(volumes.size());
+    CHECK(GorillaCodec::decodeVarints(encoded.data(), encoded.size(), volumes.size(), decodedVolumes.data()));
+    CHECK(decodedVolumes == volumes);
+    CHECK(!GorillaCodec::decodeVarints(encoded.data(), encoded.size() - 1, volumes.size(), decodedVolumes.data()));
+}
+
+static void testCompressedCache() {
+    std::string csv = "timestamp,open,high,low,close,volume\n";
+    for (int i = 0; i < 10000; ++i) { // Spans several blocks, the last one partial
+        char row[128];
+        std::snprintf(row, sizeof(row), "2023-01-02 %02d:%02d:%02d,%.2f,%.2f,%.2f,%.2f,%d\n",
+                      i / 3600, i / 60 % 60, i % 60, 100 + (i % 50) * 0.25, 101 + (i % 50) * 0.25,
+                      99 + (i % 50) * 0.25, 100.5 + (i % 50) * 0.25, 1000 + i % 977);
+        csv += row;
+    }
+    std::string path = writeTempFile("gorilla.csv", csv);
+    std::string cachePath = ColumnarCache::cachePathFor(path);
+    std::remove(cachePath.c_str());
+
+    MarketData parsed;
+    CHECK(parsed.loadFromCSV(path, CsvLoadOptions{.cacheEncoding = CacheEncoding::Gorilla}));
+    std::ifstream cacheFile(cachePath, std::ios::binary | std::ios::ate);
+    size_t cacheBytes = static_cast<size_t>(cacheFile.tellg());
+    CHECK(cacheBytes > 0 && cacheBytes * 4 < parsed.getMemoryUsage());
+
+    MarketData decoded;
+    CHECK(decoded.loadFromCSV(path));
+    CHECK(decoded.size() == parsed.size());
+    CHECK(std::equal(decoded.getTimestamps().begin(), decoded.getTimestamps().end(), parsed.getTimestamps().begin()));
+    CHECK(std::equal(decoded.getLows().begin(), decoded.getLows().end(), parsed.getLows().begin()));
+    CHECK(std::equal(decoded.getCloses().begin(), decoded.getCloses().end(), parsed.getCloses().begin()));
+    CHECK(std::equal(decoded.getVolumes().begin(), decoded.getVolumes().end(), parsed.getVolumes().begin()));
+
+    // A stream over the compressed cache yields the same rows
+    auto stream = MarketDataStream::open(path);
+    ColumnBuffers streamed;
+    while (stream && stream->read(streamed) > 0) {
+    }
+    CHECK(streamed.size() == parsed.size());
+    CHECK(std::equal(streamed.open.begin(), streamed.open.end(), parsed.getOpens().begin(), parsed.getOpens().end()));
+
+    std::remove(cachePath.c_str());
+    std::remove(path.c_str());
+}
+
+static void testDatasetCache() {
+    std::string csv = "timestamp,open,high,low,close,volume\n";
+    for (int day = 1; day <= 28; ++day) {
+        csv += "2023-02-" + std::string(day < 10 ? "0" : "") + std::to_string(day) + ",1,2,0.5,1.5,100\n";
+    }
+    std::string pathA = writeTempFile("dataset_a.csv", csv);
+    std::string pathB = writeTempFile("dataset_b.csv", csv);
+
+    // Concurrent misses on one file load it once and share the result
+    DatasetCache cache;
+    std::vector<std::shared_ptr<const MarketData> > results(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&, i] { results[i] = cache.get(pathA); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& result : results) {
+        CHECK(result && result == results[0] && result->size() == 28);
+    }
+    DatasetCacheStats stats = cache.getStats();
+    CHECK(stats.misses == 1 && stats.hits == 7 && stats.entries == 1);
+
+    // A budget that fits one dataset evicts the least recently used one
+    cache.setByteBudget(results[0]->getMemoryUsage());
+    auto b = cache.get(pathB);
+    stats = cache.getStats();
+    CHECK(stats.entries == 1 && stats.evictions == 1);
+    CHECK(results[0]->size() == 28); // Evicted data stays valid while referenced
+
+    bool threw = false;
+    try {
+        cache.get("/tmp/fingraph_test_missing.csv");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    // Resampled versions are cached separately and computed once
+    cache.setByteBudget(DatasetCache::kDefaultByteBudget);
+    auto weekly = cache.get(pathA, 7 * 86400);
+    CHECK(weekly && weekly->size() == 5); // Buckets are aligned to the epoch (a Thursday)
+    CHECK(cache.get(pathA, 7 * 86400) == weekly);
+    CHECK(cache.get(pathA, 0) == cache.get(pathA));
+    CHECK(cache.getStats().entries == 3);
+
+    // A new version of a file drops every entry cached from the old one
+    writeTempFile("dataset_a.csv", csv + "2023-03-01,1,2,0.5,1.5,100\n");
+    CHECK(cache.get(pathA)->size() == 29);
+    CHECK(cache.getStats().entries == 2);
+
+    for (const auto& path : {pathA, pathB}) {
+        std::remove(path.c_str());
+        std::remove(ColumnarCache::cachePathFor(path).c_str());
+    }
+}
+
+static void testResampler() {
+    // Minute bars from 09:30 to 10:14 into 15-minute bars
+    ColumnBuffers minutes;
+    const int64_t open = 1672651800; // 2023-01-02 09:30:00 UTC
+    for (int i = 0; i < 45; ++i) {
+        double price = 100 + i;
+        minutes.append(open + i * 60, price, price + (i == 20 ? 50 : 1), price - (i == 3 ? 40 : 1), price + 0.5, 10);
+    }
+    MarketData md;
+    md.assign(std::move(minutes));
+
+    MarketData bars = md.resample(15 * 60);
+    CHECK(bars.size() == 3);
+    CHECK(bars.getTimestamps()[0] == open && bars.getTimestamps()[2] == open + 30 * 60);
+    CHECK(bars.getOpens()[1] == 115 && bars.getCloses()[1] == 129.5);
+    CHECK(bars.getHighs()[1] == 170 && bars.getLows()[0] == 63);
+    CHECK(bars.getVolumes()[2] == 150);
+
+    // Buckets with no input produce no bar; times before the epoch floor correctly
+    ColumnBuffers sparse;
+    sparse.append(-90, 1, 1, 1, 1, 1);
+    sparse.append(-30, 2, 2, 2, 2, 1);
+    sparse.append(600, 3, 3, 3, 3, 1);
+    MarketData sparseData;
+    sparseData.assign(std::move(sparse));
+    MarketData resampled = sparseData.resample(60);
+    CHECK(resampled.size() == 3 && resampled.getTimestamps()[0] == -120 && resampled.getTimestamps()[1] == -60);
+}
+
+static void testDatabaseMarketData() {
+    std::string path = "/tmp/fingraph_test_market.db";
+    std::remove(path.c_str());
+    DatabaseService database(path);
+    CHECK(database.connect());
+
+    const int64_t day = 86400;
+    const int64_t first = 1672531200; // 2023-01-01 00:00:00 UTC
+    std::vector<MarketDataRecord> records;
+    for (int i = 0; i < 10; ++i) {
+        records.push_back({"AAPL", toTimePoint(first + i * day), 100.0 + i, 101.0 + i, 99.0 + i, 100.5 + i, 1000 + i});
+    }
+    records.push_back({"MSFT", toTimePoint(first), 300, 301, 299, 300.5, 5000});
+    CHECK(database.saveMarketData(records));
+
+    // Timestamps come back as UTC epoch seconds, independent of the local time zone
+    MarketData all;
+    CHECK(database.loadMarketData("AAPL", 0, 0, all));
+    CHECK(all.size() == 10);
+    CHECK(all.getTimestamps()[0] == first && all.getTimestamps()[9] == first + 9 * day);
+    CHECK(all.getCloses()[3] == 103.5 && all.getVolumes()[9] == 1009);
+
+    // Inclusive range, pushed down into the query
+    MarketData window;
+    CHECK(database.loadMarketData("AAPL", first + 2 * day, first + 5 * day, window));
+    CHECK(window.size() == 4 && window.getOpens()[0] == 102 && window.getTimestamps()[3] == first + 5 * day);
+
+    MarketData none;
+    CHECK(database.loadMarketData("GOOG", 0, 0, none) && none.empty());
+}
+
+static bool near(double a, double b, double tolerance = 1e-9) {
+    return std::abs(a - b) <= tolerance * std::max(1.0, std::abs(b));
+}
+
+static void testIndicators() {
+    std::vector<double> prices;
+    for (int i = 0; i < 500; ++i) {
+        prices.push_back(1000 + 50 * std::sin(i / 7.0) + (i % 5) * 0.25);
+    }
+    const size_t n = prices.size(), period = 14;
+    std::vector<double> out(n);
+
+    // Batch results against naive recomputation over each window
+    SimpleMovingAverage(period).compute(prices, out);
+    RollingStdDev stdDev(period);
+    std::vector<double> deviations(n);
+    stdDev.compute(prices, deviations);
+    std::vector<double> lows(n), highs(n);
+    RollingMin(period).compute(prices, lows);
+    RollingMax(period).compute(prices, highs);
+    CHECK(std::isnan(out[period - 2]) && std::isnan(deviations[period - 2]) && std::isnan(lows[period - 2]));
+    bool windowsMatch = true;
+    for (size_t i = period - 1; i < n; ++i) {
+        double sum = 0, squares = 0;
+        for (size_t j = i + 1 - period; j <= i; ++j) {
+            sum += prices[j];
+        }
+        double mean = sum / period;
+        for (size_t j = i + 1 - period; j <= i; ++j) {
+            squares += (prices[j] - mean) * (prices[j] - mean);
+        }
+        auto window = std::span<const double>(prices).subspan(i + 1 - period, period);
+        windowsMatch = windowsMatch && near(out[i], mean) && near(deviations[i], std::sqrt(squares / period), 1e-7) &&
+                       lows[i] == *std::min_element(window.begin(), window.end()) &&
+                       highs[i] == *std::max_element(window.begin(), window.end());
+    }
+    CHECK(windowsMatch);
+
+    // Simple RSI: means of the last `period` changes
+    RelativeStrengthIndex(period, RelativeStrengthIndex::Smoothing::Simple).compute(prices, out);
+    CHECK(std::isnan(out[period - 1]) && !std::isnan(out[period]));
+    double gain = 0, loss = 0;
+    for (size_t j = n - period; j < n; ++j) {
+        double change = prices[j] - prices[j - 1];
+        (change > 0 ? gain : loss) += std::abs(change);
+    }
+    CHECK(near(out[n - 1], 100 * gain / (gain + loss)));
+
+    // Wilder smoothing: seeded with the simple mean, then avg += (x - avg) / period
+    std::vector<double> steps = {1, 2, 3, 2, 4};
+    RelativeStrengthIndex wilder(2);
+    wilder.compute(steps, out);
+    // Changes +1 +1 -1 +2: seed gain 1, loss 0 -> 100; then gain 0.5, loss 0.5 -> 50; then gain 1.25, loss 0.25
+    CHECK(out[2] == 100 && out[3] == 50 && near(out[4], 100 * 1.25 / 1.5));
+    RelativeStrengthIndex flat(2);
+    flat.update(5);
+    flat.update(5);
+    CHECK(flat.update(5) == 50);
+
+    // Simple smoothing keeps RSIStrategy's capped mapping for windows without losses
+    std::vector<double> rising = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}, level(12, 5.0), simple(12);
+    for (const auto& series : {rising, level}) {
+        RelativeStrengthIndex(3, RelativeStrengthIndex::Smoothing::Simple).compute(series, simple);
+        RelativeStrengthIndex streamed(3, RelativeStrengthIndex::Smoothing::Simple);
+        bool capped = true;
+        for (size_t i = 0; i < series.size(); ++i) {
+            double value = streamed.update(series[i]);
+            capped = capped && (i < 3 || (simple[i] == kRsiWithoutLosses && value == kRsiWithoutLosses));
+        }
+        CHECK(capped && near(kRsiWithoutLosses, 100 - 100.0 / 101));
+    }
+    RelativeStrengthIndex wilderRising(3);
+    for (double price : rising) {
+        wilderRising.update(price);
+    }
+    CHECK(wilderRising.getValue() == 100);
+
+    // EMA seeded with the mean; MACD is the difference of two of them
+    ExponentialMovingAverage ema(3);
+    ema.compute(steps, out);
+    CHECK(std::isnan(out[1]) && out[2] == 2 && out[3] == 2 && out[4] == 3);
+    Macd macd(3, 5, 2);
+    std::vector<double> line(n), signal(n), histogram(n), fast(n), slow(n);
+    macd.compute(prices, line, signal, histogram);
+    ExponentialMovingAverage(3).compute(prices, fast);
+    ExponentialMovingAverage(5).compute(prices, slow);
+    CHECK(std::isnan(line[3]) && line[4] == fast[4] - slow[4] && std::isnan(signal[4]) && !std::isnan(signal[5]));
+    CHECK(histogram[n - 1] == line[n - 1] - signal[n - 1]);
+
+    // ATR: true range extends to the previous close
+    std::vector<double> high = {10, 12, 11}, low = {9, 11, 8}, close = {9.5, 11.5, 9};
+    AverageTrueRange atr(2);
+    atr.compute(high, low, close, out);
+    CHECK(std::isnan(out[0]) && out[1] == 1.75 && out[2] == (1.75 + 3.5) / 2);
+
+    // Push mode continues where a batch left off, bar for bar
+    SimpleMovingAverage batch(period), pushed(period);
+    std::vector<double> head(n);
+    batch.compute(std::span<const double>(prices).first(n / 2), head);
+    bool continues = true;
+    for (size_t i = 0; i < n; ++i) {
+        double value = pushed.update(prices[i]);
+        if (i >= n / 2) {
+            continues = continues && batch.update(prices[i]) == value;
+        }
+    }
+    CHECK(continues);
+
+    // A compensated running sum does not drift over a long series (a plain one ends near 1e-7 here)
+    RollingSum drift(3);
+    for (int i = 0; i < 1000000; ++i) {
+        drift.update(std::sin(i) * 1e6 + 0.1);
+    }
+    drift.update(0.0);
+    drift.update(0.0);
+    drift.update(0.0);
+    CHECK(std::abs(drift.getSum()) < 1e-12);
+}
+
+static void testIndicatorKernels() {
+    // Lengths that leave a partial vector, a series shorter than the period and
+    // one long enough to cross the rolling sum's re-anchoring point
+    for (size_t n : {0, 1, 5, 37, 1000, 9001}) {
+        std::vector<double> a(n), b(n);
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = 100 + 20 * std::sin(i / 5.0) + (i % 3) * 0.5;
+            b[i] = 100 + 15 * std::cos(i / 11.0);
+        }
+        if (n > 20) {
+            a[17] = a[16]; // A flat step, and a NaN for the element-wise kernels
+            b[20] = std::nan("");
+        }
+        const IndicatorKernels& scalar = getScalarIndicatorKernels();
+        std::vector<double> expected(n), actual(n), expected2(n), actual2(n);
+        std::vector<int8_t> expectedCodes(n), actualCodes(n);
+        auto same = [](const std::vector<double>& x, const std::vector<double>& y, size_t count, double tolerance) {
+            for (size_t i = 0; i < count; ++i) {
+                bool bothNan = std::isnan(x[i]) && std::isnan(y[i]);
+                if (!bothNan && !(tolerance == 0 ? std::memcmp(&x[i], &y[i], sizeof(double)) == 0 : near(x[i], y[i], tolerance))) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        for (const IndicatorKernels* k : getSupportedIndicatorKernels()) {
+            // Element-wise kernels are bit-identical to the scalar reference
+            scalar.priceChanges(a.data(), n, expected.data(), expected2.data());
+            k->priceChanges(a.data(), n, actual.data(), actual2.data());
+            CHECK(same(expected, actual, n, 0) && same(expected2, actual2, n, 0));
+            scalar.relativeStrength(a.data(), b.data(), n, expected.data());
+            k->relativeStrength(a.data(), b.data(), n, actual.data());
+            CHECK(same(expected, actual, n, 0));
+            scalar.returns(a.data(), n, expected.data());
+            k->returns(a.data(), n, actual.data());
+            CHECK(same(expected, actual, n ? n - 1 : 0, 0));
+            scalar.crossovers(a.data(), b.data(), n, expectedCodes.data());
+            k->crossovers(a.data(), b.data(), n, actualCodes.data());
+            CHECK(expectedCodes == actualCodes);
+            scalar.thresholds(a.data(), n, 90, 110, expectedCodes.data());
+            k->thresholds(a.data(), n, 90, 110, actualCodes.data());
+            CHECK(expectedCodes == actualCodes);
+
+            // Reductions and the rolling sum add in another order: equal to rounding error
+            for (size_t period : {1, 3, 14, 50}) {
+                scalar.rollingSum(a.data(), n, period, 1.0 / period, expected.data());
+                k->rollingSum(a.data(), n, period, 1.0 / period, actual.data());
+                CHECK(same(expected, actual, n, 1e-12));
+            }
+            CHECK(near(k->sum(a.data(), n), scalar.sum(a.data(), n), 1e-12));
+            CHECK(near(k->sumSquaredDeviations(a.data(), n, 100), scalar.sumSquaredDeviations(a.data(), n, 100), 1e-12));
+        }
+    }
+    CHECK(std::string(getSupportedIndicatorKernels().front()->name) == "scalar");
+    CHECK(getIndicatorKernels().name == getSupportedIndicatorKernels().back()->name);
+}
+
+static void testIndicatorCache() {
+    // Concurrent misses on one key compute the column once and share it
+    IndicatorCache cache;
+    std::atomic<int> computed{0};
+    auto fill = [&](std::span<double> out) {
+        computed++;
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i] = double(i);
+        }
+    };
+    std::vector<IndicatorCache::Column> results(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&, i] { results[i] = cache.get("data#1", "SMA(close,5)", 100, fill); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& result : results) {
+        CHECK(result && result == results[0] && result->size() == 100 && (*result)[99] == 99.0);
+    }
+    CHECK(computed == 1);
+    IndicatorCacheStats stats = cache.getStats();
+    CHECK(stats.misses == 1 && stats.hits == 7 && stats.entries == 1);
+
+    // Another dataset or parameter is another entry; a budget of one column evicts the oldest
+    cache.setByteBudget(stats.bytes_in_use);
+    auto other = cache.get("data#2", "SMA(close,5)", 100, fill);
+    CHECK(other != results[0] && computed == 2);
+    stats = cache.getStats();
+    CHECK(stats.entries == 1 && stats.evictions == 1);
+    CHECK(results[0]->size() == 100); // Evicted columns stay valid while referenced
+
+    // A failed computation reaches the caller and is not cached
+    cache.setByteBudget(IndicatorCache::kDefaultByteBudget);
+    bool threw = false;
+    try {
+        cache.get("data#1", "bad", 10, [](std::span<double>) { throw std::runtime_error("bad"); });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw && cache.getStats().compute_failures == 1 && cache.getStats().entries == 1);
+
+    // Strategies with a period in common share that indicator, with unchanged signals
+    MarketData md = makeVShapedSeries(60, 60);
+    cache.clear();
+    stats = cache.getStats();
+    const std::pair<double, double> periods[] = {{5, 20}, {10, 20}, {5, 30}};
+    for (const auto& [shortPeriod, longPeriod] : periods) {
+        MovingAverageStrategy cached, uncached;
+        for (MovingAverageStrategy* strategy : {&cached, &uncached}) {
+            strategy->updateParameters({{"shortPeriod", shortPeriod}, {"longPeriod", longPeriod}});
+        }
+        cached.setIndicatorCache(&cache, "v-shape");
+        cached.initialize(md.getView());
+        uncached.initialize(md.getView());
+        for (size_t i = 0; i < md.size(); ++i) {
+            CHECK(cached.generateSignal(i) == uncached.generateSignal(i));
+        }
+    }
+    IndicatorCacheStats after = cache.getStats();
+    CHECK(after.misses - stats.misses == 4 && after.hits - stats.hits == 2); // SMA 5, 10, 20, 30
+
+    RSIStrategy oversold, overbought;
+    oversold.updateParameters({{"oversoldThreshold", 40}});
+    overbought.updateParameters({{"overboughtThreshold", 60}});
+    for (RSIStrategy* strategy : {&oversold, &overbought}) {
+        strategy->setIndicatorCache(&cache, "v-shape");
+        strategy->initialize(md.getView());
+    }
+    CHECK(cache.getStats().misses - after.misses == 1 && cache.getStats().hits - after.hits == 1);
+}
+
+static void testPortfolio() {
+    auto at = toTimePoint(1672531200);
+    Portfolio portfolio(1e8);
+    SymbolTable names;
+    for (int i = 0; i < 300; ++i) {
+        std::string symbol = "S" + std::to_string(i);
+        CHECK(portfolio.internSymbol(symbol) == SymbolId(i)); // Dense, in interning order
+        names.intern(symbol);
+    }
+    CHECK(names.find("S7") == 7 && names.find("nope") == SymbolTable::kNotFound && names.getName(9) == "S9");
+
+    // Every third symbol is bought; trades mark their symbol at the trade price
+    for (SymbolId id = 0; id < 300; id += 3) {
+        portfolio.addTrade(Trade(names.getName(id), TradeType::BUY, 10 + id, 20.0 + id * 0.5, at));
+    }
+    CHECK(portfolio.getHeldSymbols().size() == 100);
+    CHECK(portfolio.getPosition("S3") == 13 && portfolio.getPosition(SymbolId(3)) == 13);
+    CHECK(portfolio.getPosition("S4") == 0 && portfolio.getPosition("unknown") == 0);
+
+    // Many rounds of sparse price updates keep the running value equal to a full revaluation
+    auto exactValue = [&] {
+        double value = portfolio.getCash();
+        for (SymbolId id = 0; id < 300; ++id) {
+            value += portfolio.getPosition(id) * portfolio.getPrice(id);
+        }
+        return value;
+    };
+    std::vector<double> prices(300);
+    for (int round = 0; round < 500; ++round) {
+        for (SymbolId id = 0; id < 300; ++id) {
+            prices[id] = (id + round) % 7 == 0 ? 20 + std::sin(round * 0.1 + id) * 5 : std::nan("");
+        }
+        portfolio.updatePrices(prices); // NaN leaves a symbol's price as it was
+    }
+    CHECK(near(portfolio.getTotalValue(), exactValue(), 1e-13));
+    std::map<std::string, double> marks;
+    for (SymbolId id = 0; id < 300; ++id) {
+        marks[names.getName(id)] = portfolio.getPrice(id);
+    }
+    CHECK(near(portfolio.getTotalValue(marks), exactValue(), 1e-13));
+
+    // Selling out drops a symbol from the held set and the value
+    double before = portfolio.getTotalValue();
+    double price = portfolio.getPrice(SymbolId(3));
+    portfolio.addTrade(Trade("S3", TradeType::SELL, 13, price, at));
+    CHECK(portfolio.getHeldSymbols().size() == 99 && portfolio.getPosition(SymbolId(3)) == 0);
+    CHECK(near(portfolio.getTotalValue(), before, 1e-13));
+
+    // Rebalancing a few names per bar across the held set keeps the market value exact
+    for (int round = 0; round < 2000; ++round) {
+        for (SymbolId id = SymbolId(round % 3); id < 300; id += 37) {
+            double tradePrice = 20 + std::cos(round * 0.3 + id) * 5;
+            double held = portfolio.getPosition(id);
+            if (held > 0 && (round + id) % 2 == 0) {
+                portfolio.addTrade(Trade(names.getName(id), TradeType::SELL, held / 2, tradePrice, at));
+            } else {
+                portfolio.addTrade(Trade(names.getName(id), TradeType::BUY, 1.5 + id % 4, tradePrice, at));
+            }
+        }
+    }
+    double marketValue = 0.0;
+    for (SymbolId id = 0; id < 300; ++id) {
+        marketValue += portfolio.getPosition(id) * portfolio.getPrice(id);
+    }
+    CHECK(near(portfolio.getMarketValue(), marketValue, 1e-13));
+
+    // Rejected trades change nothing
+    size_t trades = portfolio.getTrades().size();
+    bool threw = false;
+    try {
+        portfolio.addTrade(Trade("S4", TradeType::SELL, 1, 10.0, at));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw && portfolio.getTrades().size() == trades);
+    threw = false;
+    try {
+        portfolio.updatePrice(SymbolId(300), 1.0);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+static void testTradeLog() {
+    auto at = toTimePoint(1672531200);
+    auto record = [&](size_t i) {
+        return TradeRecord{at + std::chrono::seconds(i), double(i), 100.0 + i, SymbolId(i % 5),
+                           i % 2 ? TradeType::SELL : TradeType::BUY};
+    };
+    TradeLog log;
+    CHECK(log.empty() && log.capacity() == 0);
+    // Crosses the block boundaries at 64, 192 and 448 records
+    for (size_t i = 0; i < 500; ++i) {
+        log.push_back(record(i));
+    }
+    CHECK(log.size() == 500 && log.capacity() == 64 + 128 + 256 + 512);
+    bool same = true;
+    for (size_t i : {0, 63, 64, 191, 192, 447, 448, 499}) {
+        same = same && log[i].price == 100.0 + i && log[i].timestamp == record(i).timestamp;
+    }
+    CHECK(same && log.back().quantity == 499);
+    size_t visited = 0;
+    for (const TradeRecord& r : log) {
+        same = same && r.quantity == double(visited++);
+    }
+    CHECK(same && visited == 500);
+
+    TradeLog copy = log;
+    TradeLog moved = std::move(log);
+    CHECK(log.empty() && log.capacity() == 0);
+    CHECK(copy.size() == 500 && moved.size() == 500 && copy[448].symbol == moved[448].symbol);
+    copy.clear();
+    CHECK(copy.empty() && copy.capacity() >= 500 && moved[499].type == TradeType::SELL);
+    TradeLog& alias = moved; // Self-move leaves the log as it was
+    moved = std::move(alias);
+    CHECK(moved.size() == 500 && moved[499].type == TradeType::SELL);
+    CHECK(std::string(toString(TradeType::BUY)) == "BUY" && std::string(toString(TradeType::SELL)) == "SELL");
+}
+
+static void testOrderBook() {
+    OrderBook book;
+    std::vector<Fill> fills;
+    auto place = [&](TradeType side, OrderType type, double price, double trail = 0) {
+        return book.place(Order{0, side, type, 1, price, trail});
+    };
+    OrderId buyLimit = place(TradeType::BUY, OrderType::LIMIT, 95);
+    OrderId sellStop = place(TradeType::SELL, OrderType::STOP, 90);
+    OrderId sellLimit = place(TradeType::SELL, OrderType::LIMIT, 105);
+    OrderId buyStop = place(TradeType::BUY, OrderType::STOP, 110);
+    OrderId market = place(TradeType::BUY, OrderType::MARKET, 0);
+    OrderId trailing = place(TradeType::SELL, OrderType::TRAILING_STOP, 100, 5);
+    CHECK(book.size() == 6 && book.hasOrders(0) && !book.hasOrders(1));
+
+    // Only the market order fills, at the open; the high of 104 moves the trailing stop to 99
+    book.processBar(0, 100, 104, 96, fills);
+    CHECK(fills.size() == 1 && fills[0].order == market && fills[0].price == 100);
+    // The low reaches the buy limit and the trailing stop; the high the sell limit
+    fills.clear();
+    book.processBar(0, 101, 106, 94, fills);
+    CHECK(fills.size() == 3 && fills[0].order == buyLimit && fills[0].price == 95);
+    CHECK(fills[1].order == trailing && fills[1].price == 99 && fills[1].side == TradeType::SELL);
+    CHECK(fills[2].order == sellLimit && fills[2].price == 105);
+    // A gap through a stop fills at the open
+    fills.clear();
+    book.processBar(0, 112, 113, 111, fills);
+    CHECK(fills.size() == 1 && fills[0].order == buyStop && fills[0].price == 112);
+    CHECK(book.cancel(sellStop) && !book.cancel(sellStop) && !book.cancel(buyStop));
+    CHECK(book.size() == 0 && !book.hasOrders(0) && book.find(sellStop) == nullptr);
+
+    bool threw = false;
+    try {
+        place(TradeType::SELL, OrderType::TRAILING_STOP, 100, 0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    // Against a scan of every order: random orders of each kind, random cancels, a random walk
+    struct Resting {
+        OrderId id;
+        Order order;
+        double extreme; // Trailing stops: best price since placement
+    };
+    std::vector<Resting> naive;
+    OrderBook indexed;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double price = 100;
+    bool same = true;
+    size_t filled = 0;
+    for (int bar = 0; bar < 2000; ++bar) {
+        for (int k = 0; k < 8; ++k) {
+            Order order{SymbolId(k % 2), unit(rng) < 0.5 ? TradeType::BUY : TradeType::SELL,
+                        static_cast<OrderType>(rng() % 4), 1, std::round((price + unit(rng) * 20 - 10) * 4) / 4,
+                        std::round(unit(rng) * 8 + 1)};
+            naive.push_back({indexed.place(order), order, order.price});
+        }
+        if (!naive.empty() && unit(rng) < 0.5) {
+            size_t victim = rng() % naive.size();
+            same = same && indexed.cancel(naive[victim].id);
+            naive.erase(naive.begin() + victim);
+        }
+        double open = price + unit(rng) - 0.5;
+        double high = std::max(open, price) + unit(rng) * 3, low = std::min(open, price) - unit(rng) * 3;
+        price = low + unit(rng) * (high - low);
+        for (SymbolId symbol = 0; symbol < 2; ++symbol) {
+            std::vector<std::pair<OrderId, double> > expected, actual;
+            for (auto it = naive.begin(); it != naive.end();) {
+                const Order& o = it->order;
+                bool buy = o.side == TradeType::BUY;
+                double trigger = o.type != OrderType::TRAILING_STOP ? o.price
+                                                                    : (buy ? it->extreme + o.trail : it->extreme - o.trail);
+                bool fallsTo = o.type == OrderType::LIMIT ? buy : !buy;
+                bool fires = o.symbol == symbol &&
+                             (o.type == OrderType::MARKET || (fallsTo ? low <= trigger : high >= trigger));
+                if (fires) {
+                    double fillPrice = o.type == OrderType::MARKET ? open
+                                       : fallsTo                   ? std::min(open, trigger)
+                                                                   : std::max(open, trigger);
+                    expected.emplace_back(it->id, fillPrice);
+                    it = naive.erase(it);
+                    continue;
+                }
+                if (o.symbol == symbol) {
+                    it->extreme = buy ? std::min(it->extreme, low) : std::max(it->extreme, high);
+                }
+                ++it;
+            }
+            fills.clear();
+            indexed.processBar(symbol, open, high, low, fills);
+            for (const Fill& fill : fills) {
+                actual.emplace_back(fill.order, fill.price);
+            }
+            std::sort(actual.begin(), actual.end());
+            same = same && actual == expected;
+            filled += fills.size();
+        }
+    }
+    CHECK(same && indexed.size() == naive.size() && filled > 5000);
+}
+
+static void testExitOrders() {
+    // Bought near the bottom of the V; the exits sell on the way up
+    MarketData md = makeVShapedSeries(30, 30);
+    BacktestEngine engine;
+    std::map<std::string, double> params = {{"shortPeriod", 3}, {"longPeriod", 10}};
+    BacktestResult plain = engine.runBacktest(md.getView(), "Moving Average Crossover", params, 10000.0);
+    CHECK(plain.trades.size() == 1); // Never sold
+
+    params["takeProfit"] = 0.05;
+    BacktestResult takeProfit = engine.runBacktest(md.getView(), "Moving Average Crossover", params, 10000.0);
+    CHECK(takeProfit.trades.size() == 2 && takeProfit.trades[1].type == TradeType::SELL);
+    double limit = takeProfit.trades[0].price * 1.05; // Filled at the limit, or at an open above it
+    CHECK(takeProfit.trades[1].price >= limit && takeProfit.trades[1].price < limit + 1);
+    CHECK(takeProfit.trades[1].timestamp > takeProfit.trades[0].timestamp && takeProfit.winRate == 1.0);
+
+    // The trailing stop never triggers on a steady rise; the take-profit still cancels it
+    params["trailingStop"] = 0.02;
+    BacktestResult both = engine.runBacktest(md.getView(), "Moving Average Crossover", params, 10000.0);
+    CHECK(both.trades.size() == 2 && both.trades[1].price == takeProfit.trades[1].price);
+
+    params["stopLoss"] = 1.5;
+    bool threw = false;
+    try {
+        engine.runBacktest(md.getView(), "Moving Average Crossover", params, 10000.0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+static void testTransactionCosts() {
+    static_assert(NoCosts::kFree && std::is_empty_v<NoCosts> && !TransactionCosts::kFree);
+    CHECK(NoCosts{}.fillPrice(TradeType::BUY, 100, 10, 0) == 100 && NoCosts{}.commission(10, 100) == 0);
+
+    TransactionCosts costs = transactionCostsFromParameters(
+        {{"commissionPerTrade", 1}, {"commissionPerShare", 0.01}, {"commissionBps", 2}, {"spreadBps", 10},
+         {"slippageBps", 5}, {"impactCoefficient", 0.1}, {"shortPeriod", 3}});
+    CHECK(!costs.isFree() && transactionCostsFromParameters({{"shortPeriod", 3}}).isFree());
+    // Half the spread plus the slippage, against the trader; impact only with volume
+    CHECK(near(costs.fillPrice(TradeType::BUY, 100, 100, 0), 100.1, 1e-12));
+    CHECK(near(costs.fillPrice(TradeType::SELL, 100, 100, 0), 99.9, 1e-12));
+    CHECK(near(costs.fillPrice(TradeType::BUY, 100, 100, 10000), 101.1, 1e-12)); // 0.1 * 100 * sqrt(1%)
+    CHECK(near(costs.commission(100, 50), 1 + 1 + 1, 1e-12));
+    bool threw = false;
+    try {
+        transactionCostsFromParameters({{"spreadBps", -1}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    // In a backtest: the buy fills above the close, pays commission and still fits the cash
+    MarketData md = makeVShapedSeries(30, 30);
+    BacktestEngine engine;
+    std::map<std::string, double> params = {{"shortPeriod", 3}, {"longPeriod", 10}};
+    BacktestResult plain = engine.runBacktest(md.getView(), "Moving Average Crossover", params, 10000.0);
+    params["spreadBps"] = 0;
+    BacktestResult zero = engine.runBacktest(md.getView(), "Moving Average Crossover", params, 10000.0);
+    CHECK(zero.totalCosts == 0 && zero.equityCurve == plain.equityCurve);
+
+    params["spreadBps"] = 20;
+    params["commissionPerTrade"] = 5;
+    BacktestResult costly = engine.runBacktest(md.getView(), "Moving Average Crossover", params, 10000.0);
+    CHECK(costly.trades.size() == 1 && plain.trades.size() == 1);
+    const TradeRecord& buy = costly.trades[0];
+    CHECK(near(buy.price, plain.trades[0].price * 1.001, 1e-12));
+    CHECK(buy.quantity * buy.price + 5 <= 10000 && (buy.quantity + 1) * buy.price + 5 > 10000);
+    CHECK(near(costly.totalCosts, 5 + buy.quantity * (buy.price - plain.trades[0].price), 1e-9));
+    CHECK(costly.equityCurve.back().second < plain.equityCurve.back().second);
+
+    // A take-profit is a limit order: the costs never push its fill below the limit
+    params["takeProfit"] = 0.05;
+    params["slippageBps"] = 50;
+    BacktestResult exited = engine.runBacktest(md.getView(), "Moving Average Crossover", params, 10000.0);
+    CHECK(exited.trades.size() == 2 && exited.trades[1].type == TradeType::SELL);
+    CHECK(exited.trades[1].price >= exited.trades[0].price * 1.05);
+}
+
+// Daily bars whose closes take normal steps from 100, opening at the previous close.
+static MarketData makeRandomWalk(size_t bars, unsigned seed) {
+    ColumnBuffers columns;
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> step(0.0, 1.0);
+    double price = 100;
+    for (size_t i = 0; i < bars; ++i) {
+        double next = std::max(price + step(rng), 1.0);
+        columns.append(1672531200 + int64_t(i) * 86400, price, std::max(price, next) + 0.5,
+                       std::min(price, next) - 0.5, next, 1000);
+        price = next;
+    }
+    MarketData md;
+    md.assign(std::move(columns));
+    return md;
+}
+
+static void testParameterSweep() {
+    // Points decode in odometer order, the last axis fastest; a point failing (not
+    // enough data for the long period) leaves a NaN row
+    ParameterGrid grid({ParameterAxis::range("shortPeriod", 2, 10, 2), {"longPeriod", {15, 30, 60, 500}}},
+                       {{"stopLoss", 0.05}});
+    CHECK(grid.size() == 20 && grid.getAxes()[0].values.size() == 5);
+    std::map<std::string, double> point;
+    grid.getPoint(7, point);
+    CHECK(point.size() == 3 && point["shortPeriod"] == 4 && point["longPeriod"] == 500 && point["stopLoss"] == 0.05);
+
+    MarketData md = makeRandomWalk(400, 11);
+
+    IndicatorCache cache;
+    BacktestEngine engine;
+    engine.setIndicatorCache(&cache);
+    ThreadPool pool(4);
+    ParameterSweep sweep(engine, pool);
+    SweepOptions options;
+    options.topK = 3;
+    SweepResult result = sweep.run(md.getView(), "Moving Average Crossover", grid, 10000.0, options, "walk");
+    CHECK(result.evaluated == 20 && result.failed == 5 && !result.cancelled && !result.firstError.empty());
+    CHECK(result.table.size() == 20 && std::isnan(result.table.sharpeRatio[3]));
+    // Each indicator was computed once: 5 short and 3 long periods
+    CHECK(cache.getStats().misses == 8);
+
+    // Every row matches a run of its own, and the top rows are the best ones
+    std::vector<size_t> bySharpe;
+    for (size_t row = 0; row < grid.size(); ++row) {
+        grid.getPoint(row, point);
+        if (point["longPeriod"] == 500) {
+            continue;
+        }
+        BacktestResult single = engine.runBacktest(md.getView(), "Moving Average Crossover", point, 10000.0);
+        CHECK(near(result.table.totalReturn[row], single.totalReturn, 1e-12));
+        CHECK(near(result.table.sharpeRatio[row], single.sharpeRatio, 1e-12));
+        CHECK(result.table.tradeCount[row] == single.trades.size());
+        bySharpe.push_back(row);
+    }
+    const std::vector<double>& sharpe = result.table.sharpeRatio;
+    std::stable_sort(bySharpe.begin(), bySharpe.end(), [&](size_t a, size_t b) { return sharpe[a] > sharpe[b]; });
+    CHECK(result.top == std::vector<size_t>(bySharpe.begin(), bySharpe.begin() + 3));
+
+    // Drawdown ranks lowest first
+    options.metric = SweepMetric::MAX_DRAWDOWN;
+    options.topK = 100;
+    SweepResult byDrawdown = sweep.run(md.getView(), "Moving Average Crossover", grid, 10000.0, options, "walk");
+    CHECK(byDrawdown.top.size() == 15);
+    for (size_t i = 1; i < byDrawdown.top.size(); ++i) {
+        CHECK(byDrawdown.table.maxDrawdown[byDrawdown.top[i - 1]] <= byDrawdown.table.maxDrawdown[byDrawdown.top[i]]);
+    }
+
+    // A cancelled sweep stops before its next chunk
+    std::atomic<bool> cancelled{true};
+    options.cancelled = &cancelled;
+    SweepResult stopped = sweep.run(md.getView(), "Moving Average Crossover", grid, 10000.0, options, "walk");
+    CHECK(stopped.cancelled && stopped.evaluated == 0 && stopped.top.empty());
+
+    bool threw = false;
+    try {
+        ParameterGrid duplicate({{"shortPeriod", {2}}, {"shortPeriod", {3}}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+static void testParameterSearch() {
+    MarketData md = makeRandomWalk(1200, 3);
+    ParameterGrid grid({ParameterAxis::range("shortPeriod", 2, 20, 1), ParameterAxis::range("longPeriod", 20, 120, 5)});
+    size_t gridBars = grid.size() * md.size();
+    IndicatorCache cache;
+    BacktestEngine engine;
+    engine.setIndicatorCache(&cache);
+    ThreadPool pool(3);
+    ParameterSweep sweep(engine, pool);
+    SweepOptions options;
+    options.metric = SweepMetric::TOTAL_RETURN;
+    options.topK = 3;
+
+    // The exhaustive ranking the searches are measured against
+    SweepResult full = sweep.run(md.getView(), "Moving Average Crossover", grid, 10000.0, options, "walk");
+    CHECK(full.barsExecuted == gridBars && full.rows.empty());
+    std::vector<size_t> byReturn(grid.size());
+    std::iota(byReturn.begin(), byReturn.end(), size_t(0));
+    const std::vector<double>& returns = full.table.totalReturn;
+    std::stable_sort(byReturn.begin(), byReturn.end(), [&](size_t a, size_t b) { return returns[a] > returns[b]; });
+    auto gridRank = [&](size_t point) {
+        return size_t(std::find(byReturn.begin(), byReturn.end(), point) - byReturn.begin());
+    };
+    // Searched points match their rows of the full sweep
+    auto matchesGrid = [&](const SweepResult& searched) {
+        bool same = true;
+        for (size_t row = 0; row < searched.table.size(); ++row) {
+            same = same && searched.table.totalReturn[row] == returns[searched.getGridIndex(row)];
+        }
+        return same;
+    };
+
+    // Successive halving ends on the full history with a few survivors of short prefixes
+    SuccessiveHalvingOptions halving;
+    halving.rungs = 3;
+    SweepResult halved = sweep.runSuccessiveHalving(md.getView(), "Moving Average Crossover", grid, 10000.0,
+                                                    options, halving, "walk");
+    CHECK(!halved.top.empty() && halved.table.size() <= grid.size() / 9 + 1 && matchesGrid(halved));
+    CHECK(halved.barsExecuted < gridBars / 2 && halved.evaluated > grid.size());
+    CHECK(gridRank(halved.getGridIndex(halved.top[0])) < 5);
+
+    // A sample of the grid to start from, drawn from the seed
+    halving.candidates = 100;
+    SweepResult sampled = sweep.runSuccessiveHalving(md.getView(), "Moving Average Crossover", grid, 10000.0,
+                                                     options, halving, "walk");
+    CHECK(sampled.evaluated < 150 && sampled.barsExecuted < gridBars / 8);
+
+    // The genetic search evaluates each point once, all on the full history
+    GeneticOptions genetic;
+    genetic.population = 16;
+    genetic.generations = 12;
+    SweepResult evolved = sweep.runGenetic(md.getView(), "Moving Average Crossover", grid, 10000.0,
+                                           options, genetic, "walk");
+    std::set<size_t> distinct(evolved.rows.begin(), evolved.rows.end());
+    CHECK(distinct.size() == evolved.rows.size() && evolved.evaluated == evolved.rows.size());
+    CHECK(evolved.barsExecuted == evolved.evaluated * md.size() && evolved.evaluated < grid.size() / 2);
+    CHECK(matchesGrid(evolved) && evolved.top.size() == 3);
+    CHECK(gridRank(evolved.getGridIndex(evolved.top[0])) < 5);
+    SweepResult again = sweep.runGenetic(md.getView(), "Moving Average Crossover", grid, 10000.0,
+                                         options, genetic, "walk");
+    CHECK(again.rows == evolved.rows && again.top == evolved.top);
+}
+
+static void testWalkForward() {
+    MarketData md = makeRandomWalk(700, 5);
+    ParameterGrid grid({ParameterAxis::range("shortPeriod", 2, 10, 2), ParameterAxis::range("longPeriod", 20, 60, 10)});
+    IndicatorCache cache;
+    BacktestEngine engine;
+    engine.setIndicatorCache(&cache);
+    ThreadPool pool(3);
+    WalkForward walkForward(engine, pool);
+    WalkForwardOptions options;
+    options.inSampleBars = 200;
+    options.outOfSampleBars = 100;
+    WalkForwardResult result = walkForward.run(md.getView(), "Moving Average Crossover", grid, 10000.0, options, "walk");
+
+    // Rolling folds test consecutive windows, the stitched curve covering each bar once
+    CHECK(result.folds.size() == 5 && !result.cancelled && result.barsExecuted > 5 * grid.size() * 200);
+    const BacktestResult& stitched = result.outOfSample;
+    CHECK(stitched.equityCurve.size() == 500);
+    CHECK(stitched.equityCurve.front().first == toTimePoint(md.getTimestamps()[200]));
+    CHECK(stitched.equityCurve.back().first == toTimePoint(md.getTimestamps()[699]));
+    double chained = 1.0;
+    size_t trades = 0;
+    ParameterSweep sweep(engine, pool);
+    for (size_t k = 0; k < result.folds.size(); ++k) {
+        const WalkForwardFold& fold = result.folds[k];
+        CHECK(fold.error.empty() && fold.inSampleBegin == 100 * k && fold.inSampleEnd == 200 + 100 * k);
+        CHECK(fold.outOfSampleBegin == fold.inSampleEnd && fold.outOfSampleEnd == fold.outOfSampleBegin + 100);
+
+        // The fold trades the in-sample best point
+        SweepOptions best;
+        best.topK = 1;
+        SweepResult inSample = sweep.run(md.getView().slice(fold.inSampleBegin, 200), "Moving Average Crossover",
+                                         grid, 10000.0, best);
+        CHECK(fold.gridIndex == inSample.top[0] && fold.inSampleValue == inSample.table.sharpeRatio[inSample.top[0]]);
+
+        // Warmed up over its lookback only, the strategy signals as it would over the full history
+        MovingAverageStrategy full, warmed;
+        full.updateParameters(fold.parameters);
+        warmed.updateParameters(fold.parameters);
+        full.initialize(md.getView());
+        size_t begin = fold.outOfSampleBegin - warmed.getMaxLookback();
+        warmed.initialize(md.getView().slice(begin, fold.outOfSampleEnd - begin));
+        for (size_t i = fold.outOfSampleBegin; i < fold.outOfSampleEnd; ++i) {
+            CHECK(warmed.generateSignal(i - begin) == full.generateSignal(i));
+        }
+        chained *= 1 + fold.totalReturn;
+        trades += fold.tradeCount;
+    }
+    CHECK(near(stitched.totalReturn, chained - 1, 1e-9) && stitched.trades.size() == trades);
+    CHECK(stitched.trades.size() == 0 ||
+          stitched.trades[0].timestamp >= toTimePoint(md.getTimestamps()[200]));
+
+    // Anchored folds optimize from the first bar
+    options.anchored = true;
+    WalkForwardResult anchored = walkForward.run(md.getView(), "Moving Average Crossover", grid, 10000.0, options);
+    CHECK(anchored.folds.size() == 5 && anchored.folds[4].inSampleBegin == 0 && anchored.folds[4].inSampleEnd == 600);
+
+    bool threw = false;
+    try {
+        options.inSampleBars = 700;
+        walkForward.run(md.getView(), "Moving Average Crossover", grid, 10000.0, options);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+static void testMovingAverageCrossover() {
+    MarketData md = makeVShapedSeries(30, 30);
+    MovingAverageStrategy strategy;
+    strategy.updateParameters({{"shortPeriod", 3}, {"longPeriod", 10}});
+    strategy.initialize(md.getView());
+
+    size_t buys = 0;
+    for (size_t i = 0; i < md.size(); ++i) {
+        buys += strategy.generateSignal(i) == Signal::BUY;
+    }
+    CHECK(buys == 1);
+
+    // The bulk call matches the per-bar one, including past the end of the data
+    std::vector<Signal> signals(md.size() + 5, Signal::BUY);
+    strategy.generateSignals(signals);
+    for (size_t i = 0; i < signals.size(); ++i) {
+        CHECK(signals[i] == strategy.generateSignal(i));
+    }
+}
+
+// Forwards to a MovingAverageStrategy through the virtual interface only, so the
+// engine drives it with the generic loop rather than one specialized for its type.
+class ForwardingStrategy : public Strategy {
+public:
+    ForwardingStrategy() : Strategy("Forwarding Moving Average") {}
+    void initialize(const MarketDataView& data) override { inner_.initialize(data); }
+    Signal generateSignal(size_t index) const override { return inner_.generateSignal(index); }
+    void generateSignals(std::span<Signal> out) const override { inner_.generateSignals(out); }
+    void updateParameters(const std::map<std::string, double>& params) override { inner_.updateParameters(params); }
+    size_t getMaxLookback() const override { return inner_.getMaxLookback(); }
+
+private:
+    MovingAverageStrategy inner_;
+};
+
+static void testStrategyRegistry() {
+    static_assert(CompiledStrategy<MovingAverageStrategy> && !CompiledStrategy<ForwardingStrategy>);
+    MarketData md = makeVShapedSeries(60, 60);
+    BacktestEngine engine;
+    engine.registerStrategy(std::make_unique<ForwardingStrategy>());
+    CHECK(engine.getAvailableStrategies().size() == 3);
+
+    // The specialized and the generic loop agree exactly
+    const std::map<std::string, double> params = {{"shortPeriod", 3}, {"longPeriod", 10}};
+    BacktestResult compiled = engine.runBacktest(md.getView(), "Moving Average Crossover", params, 10000.0);
+    BacktestResult generic = engine.runBacktest(md.getView(), "Forwarding Moving Average", params, 10000.0);
+    CHECK(!compiled.trades.empty() && compiled.trades.size() == generic.trades.size());
+    CHECK(compiled.equityCurve == generic.equityCurve);
+    CHECK(compiled.sharpeRatio == generic.sharpeRatio);
+
+    // A run starts from the registered defaults, not from the previous run's parameters
+    BacktestResult defaults = BacktestEngine().runBacktest(md.getView(), "Moving Average Crossover", {}, 10000.0);
+    BacktestResult afterOther = engine.runBacktest(md.getView(), "Moving Average Crossover", {}, 10000.0);
+    CHECK(afterOther.equityCurve == defaults.equityCurve);
+
+    // Concurrent runs on one engine match serial ones
+    const std::map<std::string, double> sweep[] = {
+        {{"shortPeriod", 3}, {"longPeriod", 10}}, {{"shortPeriod", 5}, {"longPeriod", 20}},
+        {{"shortPeriod", 2}, {"longPeriod", 8}}, {{"shortPeriod", 4}, {"longPeriod", 15}}};
+    std::vector<BacktestResult> serial, concurrent(2 * std::size(sweep));
+    for (const auto& params : sweep) {
+        serial.push_back(engine.runBacktest(md.getView(), "Moving Average Crossover", params, 10000.0));
+    }
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < concurrent.size(); ++i) {
+        threads.emplace_back([&, i] {
+            concurrent[i] = engine.runBacktest(md.getView(), "Moving Average Crossover", sweep[i % std::size(sweep)],
+                                               10000.0);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < concurrent.size(); ++i) {
+        CHECK(concurrent[i].equityCurve == serial[i % std::size(sweep)].equityCurve);
+    }
+
+    bool threw = false;
+    try {
+        engine.runBacktest(md.getView(), "No Such Strategy", {}, 10000.0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+static void testLiveSignals() {
+    // Oscillating closes with many crossovers and threshold hits
+    ColumnBuffers columns;
+    for (int i = 0; i < 2000; ++i) {
+        double price = 100 + 10 * std::sin(i / 9.0) + 3 * std::sin(i / 2.3) + (i % 7) * 0.3;
+        columns.append(1672531200 + i * 60, price, price + 1, price - 1, price, 1000);
+    }
+    MarketData md;
+    md.assign(std::move(columns));
+
+    // Feeding bars one at a time gives exactly the batch signals
+    auto checkEquivalent = [&](Strategy& strategy, const std::map<std::string, double>& params) {
+        strategy.updateParameters(params);
+        strategy.initialize(md.getView());
+        std::vector<Signal> batch(md.size());
+        strategy.generateSignals(batch);
+        size_t trades = 0;
+        for (size_t i = 0; i < md.size(); ++i) {
+            Signal live = strategy.onBar(md.getView().getBar(i));
+            CHECK(live == batch[i]);
+            trades += live != Signal::NONE;
+        }
+        CHECK(trades > 0);
+    };
+    MovingAverageStrategy ma;
+    for (const auto& params : {std::map<std::string, double>{{"shortPeriod", 3}, {"longPeriod", 10}},
+                               std::map<std::string, double>{{"shortPeriod", 10}, {"longPeriod", 30}},
+                               std::map<std::string, double>{{"shortPeriod", 1}, {"longPeriod", 50}}}) {
+        checkEquivalent(ma, params); // updateParameters starts a new stream
+    }
+    RSIStrategy rsi;
+    for (const auto& params : {std::map<std::string, double>{{"period", 14}},
+                               std::map<std::string, double>{{"period", 5}, {"oversoldThreshold", 20}},
+                               std::map<std::string, double>{{"period", 30}, {"overboughtThreshold", 60}}}) {
+        checkEquivalent(rsi, params);
+    }
+
+    // resetStream() starts over: the second pass repeats the first
+    std::vector<Signal> first, second;
+    for (std::vector<Signal>* pass : {&first, &second}) {
+        rsi.resetStream();
+        for (size_t i = 0; i < 200; ++i) {
+            pass->push_back(rsi.onBar(md.getView().getBar(i)));
+        }
+    }
+    CHECK(first == second);
+
+    bool threw = false;
+    try {
+        ForwardingStrategy().onBar(md.getView().getBar(0));
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+static void testStreamingBacktest() {
+    // An oscillating series long enough to span many stream blocks
+    std::string csv = "timestamp,open,high,low,close,volume\n";
+    for (int i = 0; i < 600; ++i) {
+        double price = 100 + 10 * std::sin(i / 9.0) + (i % 7) * 0.3;
+        char stamp[32];
+        std::snprintf(stamp, sizeof(stamp), "2023-01-02 %02d:%02d:00", i / 60, i % 60);
+        csv += std::string(stamp) + "," + std::to_string(price) + "," + std::to_string(price + 1) + "," +
+               std::to_string(price - 1) + "," + std::to_string(price) + ",1000\n";
+    }
+    std::string path = writeTempFile("stream.csv", csv);
+    std::remove(ColumnarCache::cachePathFor(path).c_str());
+
+    MarketData md;
+    CHECK(md.loadFromCSV(path, CsvLoadOptions{.useBinaryCache = false}));
+
+    BacktestEngine engine;
+    const std::pair<std::string, std::map<std::string, double>> runs[] = {
+        {"Moving Average Crossover", {{"shortPeriod", 5}, {"longPeriod", 20}}},
+        {"RSI Mean Reversion", {{"period", 14}}}};
+    for (const auto& [strategy, params] : runs) {
+        BacktestResult expected = engine.runBacktest(md.getView(), strategy, params, 10000.0);
+        CHECK(!expected.trades.empty());
+
+        // Blocks much smaller than the series, from the CSV and then from the .fgc cache
+        for (bool useCache : {false, true}) {
+            if (useCache) {
+                MarketData warm;
+                CHECK(warm.loadFromCSV(path)); // Writes the cache
+            }
+            auto stream = MarketDataStream::open(path, {.blockBytes = 700, .useBinaryCache = useCache});
+            CHECK(stream != nullptr);
+            if (!stream) continue;
+            BacktestResult streamed = engine.runBacktest(*stream, strategy, params, 10000.0);
+
+            CHECK(stream->getLoadReport().rowsLoaded == md.size());
+            CHECK(streamed.trades.size() == expected.trades.size());
+            for (size_t i = 0; i < streamed.trades.size() && i < expected.trades.size(); ++i) {
+                CHECK(streamed.trades[i].price == expected.trades[i].price);
+                CHECK(streamed.trades[i].timestamp == expected.trades[i].timestamp);
+            }
+            CHECK(streamed.totalReturn == expected.totalReturn);
+            CHECK(streamed.maxDrawdown == expected.maxDrawdown);
+            CHECK(std::abs(streamed.sharpeRatio - expected.sharpeRatio) < 1e-9);
+            CHECK(streamed.equityCurve.empty());
+        }
+    }
+    std::remove(ColumnarCache::cachePathFor(path).c_str());
+    std::remove(path.c_str());
+}
 
 int main() {
     std::cout << "Running tests..." << std::endl;
-    // Add your test cases here
+    testParseTimestamp();
+    testLoadFromCSV();
+    testParallelParse();
+    testColumnarStorage();
+    testRangeViews();
+    testMarketPanel();
+    testBinaryCache();
+    testGorillaCodec();
+    testCompressedCache();
+    testDatasetCache();
+    testResampler();
+    testDatabaseMarketData();
+    testIndicators();
+    testIndicatorKernels();
+    testIndicatorCache();
+    testPortfolio();
+    testTradeLog();
+    testOrderBook();
+    testMovingAverageCrossover();
+    testStrategyRegistry();
+    testExitOrders();
+    testTransactionCosts();
+    testParameterSweep();
+    testParameterSearch();
+    testWalkForward();
+    testLiveSignals();
+    testStreamingBacktest();
+
+    if (g_failures > 0) {
+        std::cerr << g_failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All tests passed" << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -36,7 +36,8 @@ std::string DataService::getDataPath(const std::string& dataId) const {
 std::vector<std::string> DataService::listAvailableData() const {
     std::vector<std::string> dataIds;
     for (const auto& entry : std::filesystem::directory_iterator(uploadDirectory_)) {
-        if (entry.is_regular_file()) {
+        // Skip the simulation engine's binary column caches (<dataId>.fgc), temporaries included
+        if (entry.is_regular_file() && entry.path().extension() != ".fgc") {
             dataIds.push_back(entry.path().filename().string());
         }
     }